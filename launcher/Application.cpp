@@ -41,13 +41,13 @@
  */
 
 #include "Application.h"
+#include "BatchRunner.h"
 #include "BuildConfig.h"
 
 #include "DataMigrationTask.h"
 #include "java/JavaInstallList.h"
 #include "net/PasteUpload.h"
-#include "pathmatcher/MultiMatcher.h"
-#include "pathmatcher/SimplePrefixMatcher.h"
+#include "pathmatcher/CompiledMatcher.h"
 #include "tasks/Task.h"
 #include "tools/GenericProfiler.h"
 #include "ui/InstanceWindow.h"
@@ -245,7 +245,14 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
           { { "a", "profile" }, "Use the account specified by its profile name (only valid in combination with --launch)", "profile" },
           { "alive", "Write a small '" + liveCheckFile + "' file after the launcher starts" },
           { { "I", "import" }, "Import instance or resource from specified local path or URL", "url" },
-          { "show", "Opens the window for the specified instance (by instance ID)", "show" } });
+          { "show", "Opens the window for the specified instance (by instance ID)", "show" },
+          { "batch",
+            "Run operations on instances without a GUI and print JSON progress to stdout "
+            "(comma separated: update, check-mods, download, export)",
+            "operations" },
+          { "instances", "Instances to use with --batch (comma separated instance IDs, all instances by default)", "instances" },
+          { "jobs", "Number of instances --batch works on at once (by default the concurrent tasks setting)", "count" },
+          { "export-dir", "Folder --batch export writes the instance zips to (current folder by default)", "directory" } });
     // Has to be positional for some OS to handle that properly
     parser.addPositionalArgument("URL", "Import the resource(s) at the given URL(s) (same as -I / --import)", "[URL...]");
 
@@ -262,6 +269,14 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     m_instanceIdToShowWindowOf = parser.value("show");
 
+    m_batchOperations = parser.value("batch");
+    for (auto id : parser.value("instances").split(',')) {
+        if (!id.trimmed().isEmpty())
+            m_batchInstances.append(id.trimmed());
+    }
+    // relative to where we were started from, the working directory changes to the data folder below
+    m_batchExportDir = QDir::current().absoluteFilePath(parser.value("export-dir"));
+
     for (auto url : parser.values("import")) {
         m_urlsToImport.append(normalizeImportUrl(url));
     }
@@ -278,6 +293,26 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         return;
     }
 
+    if (!m_batchOperations.isEmpty()) {
+        QString error;
+        BatchRunner::parseOperations(m_batchOperations, error);
+        if (parser.isSet("jobs")) {
+            bool ok = false;
+            m_batchJobs = parser.value("jobs").toInt(&ok);
+            if (!ok || m_batchJobs < 1)
+                error = "--jobs needs a positive number";
+        }
+        if (!error.isEmpty()) {
+            std::cerr << error.toStdString() << std::endl;
+            m_status = Application::Failed;
+            return;
+        }
+    } else if (!m_batchInstances.isEmpty() || parser.isSet("jobs") || parser.isSet("export-dir")) {
+        std::cerr << "--instances, --jobs and --export-dir can only be used in combination with --batch!" << std::endl;
+        m_status = Application::Failed;
+        return;
+    }
+
     QString origcwdPath = QDir::currentPath();
     QString binPath = applicationDirPath();
 
@@ -369,6 +404,11 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         // FIXME: you can run the same binaries with multiple data dirs and they won't clash. This could cause issues for updates.
         m_peerInstance = new LocalPeer(this, appID);
         connect(m_peerInstance, &LocalPeer::messageReceived, this, &Application::messageReceived);
+        if (m_peerInstance->isClient() && !m_batchOperations.isEmpty()) {
+            std::cerr << "--batch cannot run while the launcher is already running with the same data folder!" << std::endl;
+            m_status = Application::Failed;
+            return;
+        }
         if (m_peerInstance->isClient()) {
             int timeout = 2000;
 
@@ -887,6 +927,8 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_metacache->addBase("translations", QDir("translations").absolutePath());
         m_metacache->addBase("meta", QDir("meta").absolutePath());
         m_metacache->addBase("java", QDir("cache/java").absolutePath());
+        m_metacache->addBase("skins", QDir("cache/skins").absolutePath());
+        m_metacache->addBase("api", QDir("cache/api").absolutePath());
         m_metacache->Load();
         qDebug() << "<> Cache initialized.";
     }
@@ -916,6 +958,8 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
             // save any remaining instance state
             m_instances->saveNow();
         }
+        // write out settings changes that are still waiting for their save timer, and any later ones right away
+        SettingsObject::shutdown();
         if (logFile) {
             logFile->flush();
             logFile->close();
@@ -1044,7 +1088,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
 #endif
 
-        if (is_tmp_noexec) {
+        if (is_tmp_noexec && m_batchOperations.isEmpty()) {
             auto infoMsg =
                 tr("Your /tmp directory is currently mounted with the 'noexec' flag enabled.\n"
                    "Some versions of Minecraft may not launch.\n"
@@ -1061,7 +1105,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         }
     }
 
-    if (createSetupWizard()) {
+    if (m_batchOperations.isEmpty() && createSetupWizard()) {
         return;
     }
 
@@ -1186,6 +1230,10 @@ void Application::setupWizardFinished(int status)
 void Application::performMainStartupAction()
 {
     m_status = Application::Initialized;
+    if (!m_batchOperations.isEmpty()) {
+        startBatch();
+        return;
+    }
     if (!m_instanceIdToLaunch.isEmpty()) {
         auto inst = instances()->getInstanceById(m_instanceIdToLaunch);
         if (inst) {
@@ -1253,6 +1301,21 @@ void Application::performMainStartupAction()
     }
 }
 
+void Application::startBatch()
+{
+    QString error;
+    auto operations = BatchRunner::parseOperations(m_batchOperations, error);
+    auto jobs = m_batchJobs > 0 ? m_batchJobs : m_settings->get("NumberOfConcurrentTasks").toInt();
+    qDebug() << "<> Running batch" << m_batchOperations << "with" << jobs << "jobs";
+
+    m_batchRunner = new BatchRunner(operations, m_batchInstances, jobs, m_batchExportDir, this);
+    connect(m_batchRunner, &BatchRunner::finished, this, [this](bool success) {
+        m_status = success ? Application::Succeeded : Application::Failed;
+        exit(success ? 0 : 1);
+    });
+    m_batchRunner->start();
+}
+
 void Application::showFatalErrorMessage(const QString& title, const QString& content)
 {
     m_status = Application::Failed;
@@ -1262,6 +1325,9 @@ void Application::showFatalErrorMessage(const QString& title, const QString& con
 
 Application::~Application()
 {
+    // in case we never got to aboutToQuit, the settings objects owned by the application still write on destruction
+    SettingsObject::shutdown();
+
     // Shut down logger by setting the logger function to nothing
     qInstallMessageHandler(nullptr);
 
@@ -1838,19 +1904,18 @@ bool Application::handleDataMigration(const QString& currentData,
 
     if (!currentExists) {
         // Migrate!
-        auto matcher = std::make_shared<MultiMatcher>();
-        matcher->add(std::make_shared<SimplePrefixMatcher>(configFile));
-        matcher->add(std::make_shared<SimplePrefixMatcher>(
-            BuildConfig.LAUNCHER_CONFIGFILE));  // it's possible that we already used that directory before
-        matcher->add(std::make_shared<SimplePrefixMatcher>("logs/"));
-        matcher->add(std::make_shared<SimplePrefixMatcher>("accounts.json"));
-        matcher->add(std::make_shared<SimplePrefixMatcher>("accounts/"));
-        matcher->add(std::make_shared<SimplePrefixMatcher>("assets/"));
-        matcher->add(std::make_shared<SimplePrefixMatcher>("icons/"));
-        matcher->add(std::make_shared<SimplePrefixMatcher>("instances/"));
-        matcher->add(std::make_shared<SimplePrefixMatcher>("libraries/"));
-        matcher->add(std::make_shared<SimplePrefixMatcher>("mods/"));
-        matcher->add(std::make_shared<SimplePrefixMatcher>("themes/"));
+        auto matcher = std::make_shared<CompiledMatcher>();
+        matcher->addPrefix(configFile);
+        matcher->addPrefix(BuildConfig.LAUNCHER_CONFIGFILE);  // it's possible that we already used that directory before
+        matcher->addPrefix("logs/");
+        matcher->addPrefix("accounts.json");
+        matcher->addPrefix("accounts/");
+        matcher->addPrefix("assets/");
+        matcher->addPrefix("icons/");
+        matcher->addPrefix("instances/");
+        matcher->addPrefix("libraries/");
+        matcher->addPrefix("mods/");
+        matcher->addPrefix("themes/");
 
         ProgressDialog diag;
         DataMigrationTask task(oldData, currentData, matcher);
@@ -50,6 +50,7 @@
 
 #include "minecraft/launch/MinecraftTarget.h"
 
+class BatchRunner;
 class LaunchController;
 class LocalPeer;
 class InstanceWindow;
@@ -226,6 +227,7 @@ class Application : public QApplication {
     bool handleDataMigration(const QString& currentData, const QString& oldData, const QString& name, const QString& configFile) const;
     bool createSetupWizard();
     void performMainStartupAction();
+    void startBatch();
 
     // sets the fatal error message and m_status to Failed.
     void showFatalErrorMessage(const QString& title, const QString& content);
@@ -294,6 +296,9 @@ class Application : public QApplication {
 
     SetupWizard* m_setupWizard = nullptr;
 
+    // runs --batch instead of the main window
+    BatchRunner* m_batchRunner = nullptr;
+
    public:
     QString m_detectedGLFWPath;
     QString m_detectedOpenALPath;
@@ -304,6 +309,10 @@ class Application : public QApplication {
     bool m_liveCheck = false;
     QList<QUrl> m_urlsToImport;
     QString m_instanceIdToShowWindowOf;
+    QString m_batchOperations;
+    QStringList m_batchInstances;
+    int m_batchJobs = 0;
+    QString m_batchExportDir;
     std::unique_ptr<QFile> logFile;
 
    public:
@@ -228,7 +228,7 @@ bool BaseInstance::isLinkedToInstanceId(const QString& id) const
 void BaseInstance::iconUpdated(QString key)
 {
     if (iconKey() == key) {
-        emit propertiesChanged(this);
+        emit propertiesChanged(this, Property::Icon);
     }
 }
 
@@ -288,7 +288,7 @@ void BaseInstance::setMinecraftRunning(bool running)
         settings()->set("totalTimePlayed", current + m_timeStarted.secsTo(timeEnded));
         settings()->set("lastTimePlayed", m_timeStarted.secsTo(timeEnded));
 
-        emit propertiesChanged(this);
+        emit propertiesChanged(this, Property::State);
     }
 }
 
@@ -353,7 +353,7 @@ void BaseInstance::setLastLaunch(qint64 val)
 {
     // FIXME: if no change, do not set. setting involves saving a file.
     m_settings->set("lastLaunchTime", val);
-    emit propertiesChanged(this);
+    emit propertiesChanged(this, Property::LastLaunch);
 }
 
 void BaseInstance::setNotes(QString val)
@@ -371,7 +371,7 @@ void BaseInstance::setIconKey(QString val)
 {
     // FIXME: if no change, do not set. setting involves saving a file.
     m_settings->set("iconKey", val);
-    emit propertiesChanged(this);
+    emit propertiesChanged(this, Property::Icon);
 }
 
 QString BaseInstance::iconKey() const
@@ -383,7 +383,7 @@ void BaseInstance::setName(QString val)
 {
     // FIXME: if no change, do not set. setting involves saving a file.
     m_settings->set("name", val);
-    emit propertiesChanged(this);
+    emit propertiesChanged(this, Property::Name);
 }
 
 QString BaseInstance::name() const
@@ -85,6 +85,13 @@ class BaseInstance : public QObject, public std::enable_shared_from_this<BaseIns
         Present,
         Gone  // either nuked or invalidated
     };
+    /// What a propertiesChanged signal is about
+    enum class Property {
+        Name,
+        Icon,
+        LastLaunch,
+        State  // running, broken, crashed, update available or play time, painted over the icon
+    };
 
    public:
     /// virtual destructor to make sure the destruction is COMPLETE
@@ -223,7 +230,7 @@ class BaseInstance : public QObject, public std::enable_shared_from_this<BaseIns
     {
         if (m_hasBrokenVersion != value) {
             m_hasBrokenVersion = value;
-            emit propertiesChanged(this);
+            emit propertiesChanged(this, Property::State);
         }
     }
 
@@ -232,7 +239,7 @@ class BaseInstance : public QObject, public std::enable_shared_from_this<BaseIns
     {
         if (m_hasUpdate != value) {
             m_hasUpdate = value;
-            emit propertiesChanged(this);
+            emit propertiesChanged(this, Property::State);
         }
     }
 
@@ -241,7 +248,7 @@ class BaseInstance : public QObject, public std::enable_shared_from_this<BaseIns
     {
         if (m_crashed != value) {
             m_crashed = value;
-            emit propertiesChanged(this);
+            emit propertiesChanged(this, Property::State);
         }
     }
 
@@ -281,7 +288,7 @@ class BaseInstance : public QObject, public std::enable_shared_from_this<BaseIns
     /*!
      * \brief Signal emitted when properties relevant to the instance view change
      */
-    void propertiesChanged(BaseInstance* inst);
+    void propertiesChanged(BaseInstance* inst, BaseInstance::Property property);
 
     void launchTaskChanged(shared_qobject_ptr<LaunchTask>);
 
@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BatchRunner.h"
+
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+#include <functional>
+
+#include "Application.h"
+#include "FileIgnoreProxy.h"
+#include "FileSystem.h"
+#include "InstanceList.h"
+#include "MMCZip.h"
+#include "icons/IconList.h"
+#include "minecraft/MinecraftInstance.h"
+#include "minecraft/MinecraftLoadAndCheck.h"
+#include "minecraft/mod/tasks/ModUpdateCheckTask.h"
+#include "modplatform/ModIndex.h"
+#include "settings/SettingsObject.h"
+#include "tasks/SequentialTask.h"
+
+namespace {
+const QList<QPair<BatchRunner::Operation, QString>> operationNames = {
+    { BatchRunner::Operation::UpdateComponents, "update" },
+    { BatchRunner::Operation::CheckModUpdates, "check-mods" },
+    { BatchRunner::Operation::Download, "download" },
+    { BatchRunner::Operation::Export, "export" },
+};
+}  // namespace
+
+QList<BatchRunner::Operation> BatchRunner::parseOperations(const QString& names, QString& error)
+{
+    QList<Operation> operations;
+    for (auto name : names.split(',')) {
+        name = name.trimmed();
+        if (name.isEmpty())
+            continue;
+        auto found = std::find_if(operationNames.begin(), operationNames.end(), [&name](auto& pair) { return pair.second == name; });
+        if (found == operationNames.end()) {
+            error = QString("Unknown batch operation '%1'").arg(name);
+            return {};
+        }
+        operations.append(found->first);
+    }
+    if (operations.isEmpty())
+        error = "No batch operation given";
+    return operations;
+}
+
+QString BatchRunner::operationName(Operation operation)
+{
+    for (auto& pair : operationNames) {
+        if (pair.first == operation)
+            return pair.second;
+    }
+    return {};
+}
+
+BatchRunner::BatchRunner(QList<Operation> operations, QStringList instanceIds, int jobs, QString exportDir, QObject* parent)
+    : QObject(parent), m_operations(operations), m_instance_ids(instanceIds), m_jobs(jobs), m_export_dir(exportDir)
+{
+    m_output.open(stdout, QIODevice::WriteOnly);
+}
+
+void BatchRunner::start()
+{
+    m_timer.start();
+
+    auto instances = APPLICATION->instances();
+    auto ids = m_instance_ids;
+    if (ids.isEmpty()) {
+        for (int i = 0; i < instances->count(); i++)
+            ids.append(instances->at(i)->id());
+    }
+
+    QJsonArray operations;
+    for (auto operation : m_operations)
+        operations.append(operationName(operation));
+    report({ { "event", "start" }, { "instances", ids.size() }, { "operations", operations }, { "jobs", m_jobs } });
+
+    m_task = makeShared<ConcurrentTask>("Batch", m_jobs);
+    for (auto& id : ids) {
+        m_instance_count++;
+        auto instance = instances->getInstanceById(id);
+        if (!instance) {
+            m_failed.insert(id);
+            report({ { "event", "error" }, { "instance", id }, { "error", "No such instance" } });
+            continue;
+        }
+        m_task->addTask(instanceTask(instance));
+    }
+    connect(m_task.get(), &Task::finished, this, &BatchRunner::done);
+    m_task->start();
+}
+
+Task::Ptr BatchRunner::instanceTask(InstancePtr instance)
+{
+    auto task = makeShared<SequentialTask>(instance->id());
+    // the steps are only made once the instance's turn comes, nothing is read from disk before that
+    connect(task.get(), &Task::started, this, [this, instance, steps = task.get()] {
+        for (auto operation : m_operations) {
+            auto step = operationTask(instance, operation);
+            if (!step) {
+                m_failed.insert(instance->id());
+                break;
+            }
+            track(instance, operation, step);
+            steps->addTask(step);
+        }
+    });
+    return task;
+}
+
+Task::Ptr BatchRunner::operationTask(InstancePtr instance, Operation operation)
+{
+    if (operation == Operation::Export)
+        return exportTask(instance);
+
+    auto minecraft = std::dynamic_pointer_cast<MinecraftInstance>(instance);
+    if (!minecraft) {
+        fail(instance->id(), operation, "Not a Minecraft instance");
+        return nullptr;
+    }
+
+    switch (operation) {
+        case Operation::UpdateComponents:
+            return makeShared<MinecraftLoadAndCheck>(minecraft.get(), Net::Mode::Online);
+        case Operation::CheckModUpdates: {
+            auto task = makeShared<SequentialTask>(tr("Check mod updates"));
+            auto check = makeShared<ModUpdateCheckTask>(minecraft.get());
+            connect(check.get(), &Task::succeeded, this, [this, instance, checked = check.get()] {
+                QJsonArray updates;
+                for (auto& mod : checked->getUpdatable()) {
+                    updates.append(QJsonObject{ { "name", mod.name },
+                                                { "old_version", mod.old_version },
+                                                { "new_version", mod.new_version },
+                                                { "provider", ModPlatform::ProviderCapabilities::name(mod.provider) } });
+                }
+                QJsonArray failed;
+                for (auto& mod : checked->getFailed()) {
+                    failed.append(QJsonObject{ { "file", mod.mod->fileinfo().fileName() }, { "reason", mod.reason } });
+                }
+                report({ { "event", "mod-updates" },
+                         { "instance", instance->id() },
+                         { "updates", updates },
+                         { "skipped", QJsonArray::fromStringList(checked->getSkipped()) },
+                         { "failed", failed } });
+            });
+            task->addTask(makeShared<MinecraftLoadAndCheck>(minecraft.get(), Net::Mode::Offline));
+            task->addTask(check);
+            return task;
+        }
+        case Operation::Download: {
+            auto task = makeShared<SequentialTask>(tr("Download"));
+            task->addTask(makeShared<MinecraftLoadAndCheck>(minecraft.get(), Net::Mode::Offline));
+            for (auto step : instance->createUpdateTask()) {
+                task->addTask(step);
+            }
+            return task;
+        }
+        default:
+            return nullptr;
+    }
+}
+
+Task::Ptr BatchRunner::exportTask(InstancePtr instance)
+{
+    auto root = instance->instanceRoot();
+
+    // the same defaults as the export dialog, along with what the user excluded there
+    FileIgnoreProxy filter(root, nullptr);
+    auto prefix = QDir(root).relativeFilePath(instance->gameRoot());
+    filter.ignoreFilesWithPath().insert({ FS::PathCombine(prefix, "logs"), FS::PathCombine(prefix, "crash-reports"),
+                                          FS::PathCombine(prefix, ".cache"), FS::PathCombine(prefix, ".fabric"),
+                                          FS::PathCombine(prefix, ".quilt") });
+    filter.ignoreFilesWithName().append({ ".DS_Store", "thumbs.db", "Thumbs.db" });
+    if (QFile ignoreFile(FS::PathCombine(root, ".packignore")); ignoreFile.open(QIODevice::ReadOnly)) {
+        QStringList paths;
+        for (auto& path : QString::fromUtf8(ignoreFile.readAll()).split('\n')) {
+            if (!path.isEmpty())
+                paths.append(path);
+        }
+        filter.setBlockedPaths(paths);
+    }
+
+    APPLICATION->icons()->saveIcon(instance->iconKey(), FS::PathCombine(root, instance->iconKey() + ".png"), "PNG");
+    // instance.cfg is part of the export, it has to be up to date on disk
+    SettingsObject::flushAll();
+
+    QFileInfoList files;
+    auto filterFile = std::bind(&FileIgnoreProxy::filterFile, &filter, std::placeholders::_1);
+    if (!MMCZip::collectFileListRecursively(root, nullptr, &files, filterFile)) {
+        fail(instance->id(), Operation::Export, "Unable to list the instance files");
+        return nullptr;
+    }
+    auto output = FS::PathCombine(m_export_dir, FS::RemoveInvalidFilenameChars(instance->id()) + ".zip");
+    return makeShared<MMCZip::ExportToZipTask>(output, root, files, "", true, true);
+}
+
+void BatchRunner::track(InstancePtr instance, Operation operation, Task::Ptr task)
+{
+    QJsonObject base{ { "instance", instance->id() }, { "operation", operationName(operation) } };
+    auto timer = std::make_shared<QElapsedTimer>();
+    // whole percents are plenty for a log, and keep hundreds of parallel tasks from flooding it
+    auto percent = std::make_shared<int>(-1);
+
+    connect(task.get(), &Task::started, this, [this, base, timer] {
+        timer->start();
+        auto event = base;
+        event["event"] = "started";
+        report(event);
+    });
+    connect(task.get(), &Task::progress, this, [this, base, percent](qint64 current, qint64 total) {
+        auto now = total > 0 ? static_cast<int>(current * 100 / total) : 0;
+        if (now == *percent)
+            return;
+        *percent = now;
+        auto event = base;
+        event["event"] = "progress";
+        event["current"] = current;
+        event["total"] = total;
+        report(event);
+    });
+    connect(task.get(), &Task::finished, this, [this, base, timer, instance, step = task.get()] {
+        auto event = base;
+        event["event"] = "finished";
+        event["success"] = step->wasSuccessful();
+        if (!step->wasSuccessful()) {
+            event["error"] = step->failReason();
+            m_failed.insert(instance->id());
+        }
+        event["elapsed_ms"] = timer->elapsed();
+        report(event);
+    });
+}
+
+void BatchRunner::fail(const QString& instanceId, Operation operation, const QString& reason)
+{
+    m_failed.insert(instanceId);
+    report({ { "event", "finished" },
+             { "instance", instanceId },
+             { "operation", operationName(operation) },
+             { "success", false },
+             { "error", reason },
+             { "elapsed_ms", 0 } });
+}
+
+void BatchRunner::report(QJsonObject event)
+{
+    event["time_ms"] = m_timer.elapsed();
+    m_output.write(QJsonDocument(event).toJson(QJsonDocument::Compact) + '\n');
+    m_output.flush();
+}
+
+void BatchRunner::done()
+{
+    report({ { "event", "summary" },
+             { "instances", m_instance_count },
+             { "succeeded", m_instance_count - m_failed.size() },
+             { "failed", m_failed.size() },
+             { "elapsed_ms", m_timer.elapsed() } });
+    emit finished(m_failed.isEmpty());
+}
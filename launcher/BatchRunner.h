@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+
+#include "BaseInstance.h"
+#include "tasks/ConcurrentTask.h"
+
+/** Runs operations on many instances without showing any window, for --batch.
+ *  Instances are worked on in parallel, the operations of one instance run in order and stop at the first failure.
+ *  Progress and timings are written to stdout as one JSON object per line.
+ */
+class BatchRunner : public QObject {
+    Q_OBJECT
+   public:
+    enum class Operation { UpdateComponents, CheckModUpdates, Download, Export };
+
+    /// parses a comma separated list of operation names, returns an empty list and sets error on failure
+    static QList<Operation> parseOperations(const QString& names, QString& error);
+    static QString operationName(Operation operation);
+
+    BatchRunner(QList<Operation> operations, QStringList instanceIds, int jobs, QString exportDir, QObject* parent = nullptr);
+
+    void start();
+
+   signals:
+    void finished(bool success);
+
+   private:
+    Task::Ptr instanceTask(InstancePtr instance);
+    Task::Ptr operationTask(InstancePtr instance, Operation operation);
+    Task::Ptr exportTask(InstancePtr instance);
+    void track(InstancePtr instance, Operation operation, Task::Ptr task);
+
+    void report(QJsonObject event);
+    void fail(const QString& instanceId, Operation operation, const QString& reason);
+    void done();
+
+   private:
+    QList<Operation> m_operations;
+    QStringList m_instance_ids;
+    int m_jobs;
+    QString m_export_dir;
+
+    ConcurrentTask::Ptr m_task;
+    QElapsedTimer m_timer;
+    QFile m_output;
+    int m_instance_count = 0;
+    QSet<QString> m_failed;
+};
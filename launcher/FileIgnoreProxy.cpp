@@ -37,15 +37,42 @@
 #include "FileIgnoreProxy.h"
 
 #include <QDebug>
+#include <QDirIterator>
 #include <QFileSystemModel>
+#include <QFutureWatcher>
+#include <QLocale>
 #include <QSortFilterProxyModel>
 #include <QStack>
+#include <QtConcurrentRun>
 #include <algorithm>
 #include "FileSystem.h"
 #include "SeparatorPrefixTree.h"
 #include "StringUtils.h"
 
-FileIgnoreProxy::FileIgnoreProxy(QString root, QObject* parent) : QSortFilterProxyModel(parent), root(root) {}
+namespace {
+QString parentPath(const QString& relPath)
+{
+    auto sepIndex = relPath.lastIndexOf('/');
+    return sepIndex == -1 ? QString() : relPath.left(sepIndex);
+}
+}  // namespace
+
+FileIgnoreProxy::FileIgnoreProxy(QString root, QObject* parent)
+    : QSortFilterProxyModel(parent), root(root), m_rootPrefix(QDir(root).absolutePath() + '/')
+{
+    // the owner fills in the ignore lists right after constructing us, so index once that is done
+    QMetaObject::invokeMethod(this, [this] { startIndexing(QString()); }, Qt::QueuedConnection);
+}
+
+void FileIgnoreProxy::setSourceModel(QAbstractItemModel* sourceModel)
+{
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+    // QFileSystemModel watches the directories it has loaded, follow it to keep the index current
+    connect(sourceModel, &QAbstractItemModel::rowsInserted, this, &FileIgnoreProxy::sourceRowsInserted);
+    connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &FileIgnoreProxy::sourceRowsAboutToBeRemoved);
+    connect(sourceModel, &QAbstractItemModel::dataChanged, this, &FileIgnoreProxy::sourceDataChanged);
+}
+
 // NOTE: Sadly, we have to do sorting ourselves.
 bool FileIgnoreProxy::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
@@ -114,6 +141,13 @@ QVariant FileIgnoreProxy::data(const QModelIndex& index, int role) const
         }
     }
 
+    if (index.column() == 1 && role == Qt::DisplayRole && m_indexed) {
+        QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
+        if (fsm && fsm->isDir(sourceIndex)) {
+            return QLocale().formattedDataSize(totalSize(relPath(fsm->filePath(sourceIndex))));
+        }
+    }
+
     return sourceIndex.data(role);
 }
 
@@ -130,6 +164,8 @@ bool FileIgnoreProxy::setData(const QModelIndex& index, const QVariant& value, i
 
 QString FileIgnoreProxy::relPath(const QString& path) const
 {
+    if (path.startsWith(m_rootPrefix))
+        return path.mid(m_rootPrefix.size());
     return QDir(root).relativeFilePath(path);
 }
 
@@ -154,69 +190,34 @@ bool FileIgnoreProxy::setFilterState(QModelIndex index, Qt::CheckState state)
         if (!blocked.remove(blockedPath)) {
             auto cover = blocked.cover(blockedPath);
             qDebug() << "Blocked by cover" << cover;
-            // uncover
-            blocked.remove(cover);
-            // block all contents, except for any cover
-            QModelIndex rootIndex = fsm->index(FS::PathCombine(root, cover));
-            QModelIndex doing = rootIndex;
-            int row = 0;
-            QStack<QModelIndex> todo;
-            while (1) {
-                auto node = fsm->index(row, 0, doing);
-                if (!node.isValid()) {
-                    if (!todo.size()) {
-                        break;
-                    } else {
-                        doing = todo.pop();
-                        row = 0;
-                        continue;
+            if (!cover.isNull()) {
+                // uncover
+                blocked.remove(cover);
+                // block all contents, except for any cover
+                QStack<QString> todo;
+                todo.push(cover);
+                while (!todo.isEmpty()) {
+                    for (auto& relpath : childPaths(todo.pop())) {
+                        if (blockedPath.startsWith(relpath + '/')) {
+                            // continue processing cover later
+                            todo.push(relpath);
+                        } else if (relpath != blockedPath) {
+                            // or just block this one.
+                            blocked.insert(relpath);
+                        }
                     }
                 }
-                auto relpath = relPath(fsm->filePath(node));
-                if (blockedPath.startsWith(relpath))  // cover found?
-                {
-                    // continue processing cover later
-                    todo.push(node);
-                } else {
-                    // or just block this one.
-                    blocked.insert(relpath);
-                }
-                row++;
             }
         }
         changed = true;
     }
     if (changed) {
-        // update the thing
-        emit dataChanged(index, index, { Qt::CheckStateRole });
-        // update everything above index
-        QModelIndex up = index.parent();
-        while (1) {
-            if (!up.isValid())
-                break;
-            emit dataChanged(up, up, { Qt::CheckStateRole });
-            up = up.parent();
-        }
-        // and everything below the index
-        QModelIndex doing = index;
-        int row = 0;
-        QStack<QModelIndex> todo;
-        while (1) {
-            auto node = this->index(row, 0, doing);
-            if (!node.isValid()) {
-                if (!todo.size()) {
-                    break;
-                } else {
-                    doing = todo.pop();
-                    row = 0;
-                    continue;
-                }
-            }
-            emit dataChanged(node, node, { Qt::CheckStateRole });
-            todo.push(node);
-            row++;
-        }
+        // update the thing, everything above it and everything below it
         // siblings and unrelated nodes are ignored
+        emit dataChanged(index, index, { Qt::CheckStateRole });
+        emitAncestorsChanged(index, 0, { Qt::CheckStateRole });
+        emitDescendantsChanged(index, 0, { Qt::CheckStateRole });
+        emit sizesChanged();
     }
     return true;
 }
@@ -242,6 +243,7 @@ void FileIgnoreProxy::setBlockedPaths(QStringList paths)
     blocked.clear();
     blocked.insert(paths);
     endResetModel();
+    emit sizesChanged();
 }
 
 bool FileIgnoreProxy::filterAcceptsColumn(int source_column, const QModelIndex& source_parent) const
@@ -270,7 +272,273 @@ bool FileIgnoreProxy::ignoreFile(QFileInfo fileInfo) const
     return m_ignoreFiles.contains(fileInfo.fileName()) || m_ignoreFilePaths.covers(relPath(fileInfo.absoluteFilePath()));
 }
 
+bool FileIgnoreProxy::ignorePath(const QString& relPath) const
+{
+    return m_ignoreFiles.contains(relPath.mid(relPath.lastIndexOf('/') + 1)) || m_ignoreFilePaths.covers(relPath);
+}
+
 bool FileIgnoreProxy::filterFile(const QString& fileName) const
 {
-    return blocked.covers(fileName) || ignoreFile(QFileInfo(QDir(root), fileName));
+    return blocked.covers(fileName) || ignorePath(fileName);
+}
+
+qint64 FileIgnoreProxy::totalSize(const QString& relPath) const
+{
+    if (!m_indexed)
+        return -1;
+    auto found = m_index.constFind(relPath);
+    return found == m_index.constEnd() ? 0 : found->size;
+}
+
+qint64 FileIgnoreProxy::exportSize() const
+{
+    if (!m_indexed)
+        return -1;
+    auto size = totalSize(QString());
+    for (auto& path : blocked.toStringList()) {
+        // anything below a blocked directory is already accounted for
+        if (!blocked.covers(parentPath(path)))
+            size -= totalSize(path);
+    }
+    return size;
+}
+
+FileIgnoreProxy::Index FileIgnoreProxy::buildIndex(QString root,
+                                                   QString start,
+                                                   QStringList ignoreNames,
+                                                   SeparatorPrefixTree<'/'> ignorePaths)
+{
+    Index index;
+    index[start].isDir = true;
+    QStack<QString> todo;
+    todo.push(start);
+    while (!todo.isEmpty()) {
+        auto dir = todo.pop();
+        QDirIterator iter(dir.isEmpty() ? root : FS::PathCombine(root, dir),
+                          QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+        while (iter.hasNext()) {
+            iter.next();
+            auto info = iter.fileInfo();
+            auto name = info.fileName();
+            auto path = dir.isEmpty() ? name : dir + '/' + name;
+            if (ignoreNames.contains(name) || ignorePaths.covers(path))
+                continue;
+            index[dir].children.insert(name);
+            if (info.isDir() && !info.isSymLink()) {
+                index[path].isDir = true;
+                todo.push(path);
+                continue;
+            }
+            auto size = info.size();
+            index[path].size = size;
+            for (auto parent = dir;; parent = parentPath(parent)) {
+                index[parent].size += size;
+                if (parent == start)
+                    break;
+            }
+        }
+    }
+    return index;
+}
+
+void FileIgnoreProxy::startIndexing(const QString& relPath)
+{
+    if (m_indexing.contains(relPath))
+        return;
+    m_indexing.insert(relPath);
+    auto watcher = new QFutureWatcher<Index>(this);
+    connect(watcher, &QFutureWatcher<Index>::finished, this, [this, watcher, relPath] {
+        m_indexing.remove(relPath);
+        mergeIndex(relPath, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(&FileIgnoreProxy::buildIndex, root, relPath, m_ignoreFiles, m_ignoreFilePaths));
+}
+
+void FileIgnoreProxy::mergeIndex(const QString& relPath, const Index& index)
+{
+    if (relPath.isEmpty()) {
+        m_index = index;
+        m_indexed = true;
+    } else {
+        auto found = m_index.constFind(relPath);
+        // removed while we were scanning it
+        if (found == m_index.constEnd())
+            return;
+        auto delta = index.value(relPath).size - found->size;
+        dropFromIndex(relPath);
+        for (auto iter = index.cbegin(); iter != index.cend(); iter++) {
+            m_index.insert(iter.key(), iter.value());
+        }
+        addSize(parentPath(relPath), delta);
+    }
+
+    QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
+    if (fsm) {
+        auto proxyIndex = mapFromSource(fsm->index(relPath.isEmpty() ? root : FS::PathCombine(root, relPath)));
+        auto sizeCell = proxyIndex.sibling(proxyIndex.row(), 1);
+        emit dataChanged(sizeCell, sizeCell, { Qt::DisplayRole });
+        emitAncestorsChanged(proxyIndex, 1, { Qt::DisplayRole });
+        emitDescendantsChanged(proxyIndex, 1, { Qt::DisplayRole });
+    }
+    emit sizesChanged();
+}
+
+void FileIgnoreProxy::addSize(QString relPath, qint64 delta)
+{
+    for (;; relPath = parentPath(relPath)) {
+        auto found = m_index.find(relPath);
+        if (found != m_index.end())
+            found->size += delta;
+        if (relPath.isEmpty())
+            break;
+    }
+}
+
+void FileIgnoreProxy::dropFromIndex(const QString& relPath)
+{
+    auto found = m_index.find(relPath);
+    if (found == m_index.end())
+        return;
+    auto children = found->children;
+    m_index.erase(found);
+    for (auto& child : children) {
+        dropFromIndex(relPath.isEmpty() ? child : relPath + '/' + child);
+    }
+}
+
+QStringList FileIgnoreProxy::childPaths(const QString& relPath) const
+{
+    QStringList paths;
+    auto prefix = relPath.isEmpty() ? QString() : relPath + '/';
+    if (m_indexed) {
+        auto found = m_index.constFind(relPath);
+        if (found != m_index.constEnd()) {
+            for (auto& child : found->children)
+                paths.append(prefix + child);
+        }
+        return paths;
+    }
+    // not indexed yet, go with whatever the source model has loaded so far
+    QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
+    auto parent = fsm->index(relPath.isEmpty() ? root : FS::PathCombine(root, relPath));
+    for (int row = 0; row < fsm->rowCount(parent); row++) {
+        paths.append(prefix + fsm->fileName(fsm->index(row, 0, parent)));
+    }
+    return paths;
+}
+
+QString FileIgnoreProxy::sourceRelPath(const QModelIndex& sourceIndex) const
+{
+    QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
+    if (!fsm)
+        return {};
+    auto path = fsm->filePath(sourceIndex);
+    if (!path.startsWith(m_rootPrefix))
+        return {};
+    return path.mid(m_rootPrefix.size());
+}
+
+void FileIgnoreProxy::sourceRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (!m_indexed)
+        return;
+    QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
+    bool changed = false;
+    for (int row = first; row <= last; row++) {
+        auto sourceIndex = fsm->index(row, 0, parent);
+        auto path = sourceRelPath(sourceIndex);
+        // most of these are just the model loading a directory we already know about
+        if (path.isEmpty() || m_index.contains(path) || ignorePath(path))
+            continue;
+        auto parentEntry = m_index.find(parentPath(path));
+        if (parentEntry == m_index.end())
+            continue;
+        parentEntry->children.insert(fsm->fileName(sourceIndex));
+        if (fsm->isDir(sourceIndex)) {
+            m_index[path].isDir = true;
+            startIndexing(path);
+        } else {
+            m_index[path].size = 0;
+            addSize(path, fsm->size(sourceIndex));
+            emitAncestorsChanged(mapFromSource(sourceIndex), 1, { Qt::DisplayRole });
+            changed = true;
+        }
+    }
+    if (changed)
+        emit sizesChanged();
+}
+
+void FileIgnoreProxy::sourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    if (!m_indexed)
+        return;
+    QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
+    bool changed = false;
+    for (int row = first; row <= last; row++) {
+        auto sourceIndex = fsm->index(row, 0, parent);
+        auto path = sourceRelPath(sourceIndex);
+        auto found = m_index.constFind(path);
+        if (path.isEmpty() || found == m_index.constEnd())
+            continue;
+        addSize(parentPath(path), -found->size);
+        auto parentEntry = m_index.find(parentPath(path));
+        if (parentEntry != m_index.end())
+            parentEntry->children.remove(fsm->fileName(sourceIndex));
+        dropFromIndex(path);
+        emitAncestorsChanged(mapFromSource(sourceIndex), 1, { Qt::DisplayRole });
+        changed = true;
+    }
+    if (changed)
+        emit sizesChanged();
+}
+
+void FileIgnoreProxy::sourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+{
+    if (!m_indexed)
+        return;
+    QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
+    bool changed = false;
+    for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
+        auto sourceIndex = fsm->index(row, 0, topLeft.parent());
+        auto path = sourceRelPath(sourceIndex);
+        auto found = m_index.constFind(path);
+        if (path.isEmpty() || found == m_index.constEnd() || found->isDir)
+            continue;
+        auto delta = fsm->size(sourceIndex) - found->size;
+        if (delta == 0)
+            continue;
+        addSize(path, delta);
+        emitAncestorsChanged(mapFromSource(sourceIndex), 1, { Qt::DisplayRole });
+        changed = true;
+    }
+    if (changed)
+        emit sizesChanged();
+}
+
+void FileIgnoreProxy::emitAncestorsChanged(const QModelIndex& index, int column, const QVector<int>& roles)
+{
+    for (auto up = index.parent(); up.isValid(); up = up.parent()) {
+        auto cell = up.sibling(up.row(), column);
+        emit dataChanged(cell, cell, roles);
+    }
+}
+
+void FileIgnoreProxy::emitDescendantsChanged(const QModelIndex& index, int column, const QVector<int>& roles)
+{
+    // one ranged signal per loaded directory rather than one per item
+    QStack<QModelIndex> todo;
+    todo.push(index.sibling(index.row(), 0));
+    while (!todo.isEmpty()) {
+        auto parent = todo.pop();
+        auto rows = rowCount(parent);
+        if (rows == 0)
+            continue;
+        emit dataChanged(this->index(0, column, parent), this->index(rows - 1, column, parent), roles);
+        for (int row = 0; row < rows; row++) {
+            auto child = this->index(row, 0, parent);
+            if (hasChildren(child))
+                todo.push(child);
+        }
+    }
 }
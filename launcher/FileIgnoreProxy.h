@@ -37,6 +37,8 @@
 #pragma once
 
 #include <QFileInfo>
+#include <QHash>
+#include <QSet>
 #include <QSortFilterProxyModel>
 #include "SeparatorPrefixTree.h"
 
@@ -45,6 +47,7 @@ class FileIgnoreProxy : public QSortFilterProxyModel {
 
    public:
     FileIgnoreProxy(QString root, QObject* parent);
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
     // NOTE: Sadly, we have to do sorting ourselves.
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const;
 
@@ -71,15 +74,51 @@ class FileIgnoreProxy : public QSortFilterProxyModel {
 
     bool filterFile(const QString& fileName) const;
 
+    // sizes come from an index of the root that is built in the background and then kept up to date
+    // from the source model's file watcher. both return -1 until the index is ready
+    qint64 totalSize(const QString& relPath) const;
+    qint64 exportSize() const;
+
+   signals:
+    void sizesChanged();
+
    protected:
     bool filterAcceptsColumn(int source_column, const QModelIndex& source_parent) const;
     bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const;
 
     bool ignoreFile(QFileInfo file) const;
+    bool ignorePath(const QString& relPath) const;
+
+   private:
+    struct IndexEntry {
+        qint64 size = 0;
+        bool isDir = false;
+        QSet<QString> children;
+    };
+    using Index = QHash<QString, IndexEntry>;
+
+    static Index buildIndex(QString root, QString start, QStringList ignoreNames, SeparatorPrefixTree<'/'> ignorePaths);
+    void startIndexing(const QString& relPath);
+    void mergeIndex(const QString& relPath, const Index& index);
+    void addSize(QString relPath, qint64 delta);
+    void dropFromIndex(const QString& relPath);
+    QStringList childPaths(const QString& relPath) const;
+    QString sourceRelPath(const QModelIndex& sourceIndex) const;
+
+    void sourceRowsInserted(const QModelIndex& parent, int first, int last);
+    void sourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    void sourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+
+    void emitAncestorsChanged(const QModelIndex& index, int column, const QVector<int>& roles);
+    void emitDescendantsChanged(const QModelIndex& index, int column, const QVector<int>& roles);
 
    private:
     const QString root;
+    const QString m_rootPrefix;
     SeparatorPrefixTree<'/'> blocked;
     QStringList m_ignoreFiles;
     SeparatorPrefixTree<'/'> m_ignoreFilePaths;
+    Index m_index;
+    bool m_indexed = false;
+    QSet<QString> m_indexing;
 };
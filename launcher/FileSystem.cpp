@@ -43,13 +43,20 @@
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QMutex>
 #include <QStandardPaths>
 #include <QStorageInfo>
 #include <QTextStream>
+#include <QThreadPool>
 #include <QUrl>
+#include <QWaitCondition>
 #include <QtNetwork>
+#include <atomic>
+#include <deque>
 #include <system_error>
 
 #include "DesktopServices.h"
@@ -102,6 +109,7 @@ namespace fs = ghc::filesystem;
 #include <fcntl.h> /* Definition of FICLONE* constants */
 #include <linux/fs.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #elif defined(Q_OS_MACOS)
 #include <sys/attr.h>
@@ -1336,6 +1344,260 @@ bool clone::operator()(const QString& offset, bool dryRun)
     return err.value() == 0;
 }
 
+#if defined(Q_OS_LINUX)
+/**
+ * Copies a regular file between two open descriptors, in the kernel whenever possible:
+ * FICLONE shares the extents on CoW filesystems, copy_file_range avoids the round trip through userspace otherwise.
+ */
+static bool linux_copy_fd(int src_fd, int dst_fd, off_t size, bool cloneOnly, std::error_code& ec)
+{
+    if (ioctl(dst_fd, FICLONE, src_fd) == 0)
+        return true;
+    if (cloneOnly) {
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        return false;
+    }
+
+    off_t remaining = size;
+    bool useCopyRange = true;
+    while (remaining > 0 && useCopyRange) {
+        auto copied = copy_file_range(src_fd, nullptr, dst_fd, nullptr, remaining, 0);
+        if (copied > 0) {
+            remaining -= copied;
+            continue;
+        }
+        if (copied == 0)
+            break;
+        if (errno == EINTR)
+            continue;
+        if (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP) {
+            // not supported between these files, finish with a plain copy from where we are
+            useCopyRange = false;
+            break;
+        }
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        return false;
+    }
+    if (remaining <= 0)
+        return true;
+
+    QByteArray buffer(1024 * 1024, Qt::Uninitialized);
+    while (true) {
+        auto bytesRead = read(src_fd, buffer.data(), buffer.size());
+        if (bytesRead == 0)
+            return true;
+        if (bytesRead < 0) {
+            if (errno == EINTR)
+                continue;
+            ec = std::make_error_code(static_cast<std::errc>(errno));
+            return false;
+        }
+        auto offset = 0;
+        while (offset < bytesRead) {
+            auto written = write(dst_fd, buffer.constData() + offset, bytesRead - offset);
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                ec = std::make_error_code(static_cast<std::errc>(errno));
+                return false;
+            }
+            offset += written;
+        }
+    }
+}
+#endif
+
+bool parallel_copy::copyOne(const QString& srcPath, const QString& dstPath, std::error_code& ec)
+{
+    auto src_std = StringUtils::toStdString(srcPath);
+    auto dst_std = StringUtils::toStdString(dstPath);
+
+    if (!m_followSymlinks && fs::is_symlink(fs::symlink_status(src_std, ec))) {
+        if (m_overwrite)
+            fs::remove(dst_std, ec);
+        fs::copy_symlink(src_std, dst_std, ec);
+        return !ec;
+    }
+    if (ec)
+        return false;
+
+#if defined(Q_OS_LINUX)
+    int src_fd = open(src_std.c_str(), O_RDONLY | O_CLOEXEC);
+    if (src_fd == -1) {
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        return false;
+    }
+    struct stat st;
+    if (fstat(src_fd, &st) == -1) {
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        close(src_fd);
+        return false;
+    }
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (m_overwrite ? O_TRUNC : O_EXCL);
+    int dst_fd = open(dst_std.c_str(), flags, st.st_mode & 07777);
+    if (dst_fd == -1) {
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        close(src_fd);
+        return false;
+    }
+    bool ok = linux_copy_fd(src_fd, dst_fd, st.st_size, m_cloneOnly, ec);
+    close(src_fd);
+    if (close(dst_fd) == -1 && ok) {
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        ok = false;
+    }
+    if (!ok)
+        fs::remove(dst_std);
+    return ok;
+#else
+    if (m_cloneOnly)
+        return clone_file(srcPath, dstPath, ec);
+    auto opt = m_overwrite ? fs::copy_options::overwrite_existing : fs::copy_options::none;
+    fs::copy_file(src_std, dst_std, opt, ec);
+    return !ec;
+#endif
+}
+
+/**
+ * @brief Copies a directory and it's contents from src to dest, walking the source once and copying on a worker pool
+ * @return if there was an error during the filecopy
+ */
+bool parallel_copy::operator()()
+{
+    m_copied = 0;  // reset counter
+    m_failedPaths.clear();
+
+// NOTE always deep copy on windows. the alternatives are too messy.
+#if defined Q_OS_WIN32
+    m_followSymlinks = true;
+#endif
+
+    auto src = m_src.absolutePath();
+    auto dst = m_dst.absolutePath();
+
+    if (m_cloneOnly && !canClone(src, dst)) {
+        qWarning() << "Can not clone: not same device or not clone/reflink filesystem";
+        qDebug() << "Source path:" << src;
+        qDebug() << "Destination path:" << dst;
+        emit copyFailed(QString());
+        m_failedPaths.append(dst);
+        return false;
+    }
+
+    struct Job {
+        QString srcPath;
+        QString relativePath;
+    };
+    // bounded, so a huge tree does not end up fully queued in memory before the workers catch up
+    constexpr size_t queueLimit = 4096;
+    std::deque<Job> queue;
+    bool walkDone = false;
+    QMutex queueLock;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+
+    std::atomic<qsizetype> copied = 0;
+    std::atomic<qsizetype> total = 0;
+    std::atomic<qint64> lastReport = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QMutex failedLock;
+
+    // batch the progress reports, emitting for every file floods the receivers with signals
+    auto reportProgress = [&](bool force) {
+        constexpr qint64 reportInterval = 50;
+        auto now = timer.elapsed();
+        auto last = lastReport.load();
+        if (force || (now - last >= reportInterval && lastReport.compare_exchange_strong(last, now)))
+            emit progress(copied.load(), total.load());
+    };
+
+    auto worker = [&] {
+        while (true) {
+            Job job;
+            {
+                QMutexLocker locker(&queueLock);
+                while (queue.empty() && !walkDone)
+                    notEmpty.wait(&queueLock);
+                if (queue.empty())
+                    return;
+                job = std::move(queue.front());
+                queue.pop_front();
+                notFull.wakeOne();
+            }
+
+            auto dst_path = PathCombine(dst, job.relativePath);
+            std::error_code err;
+            ensureFilePathExists(dst_path);
+            if (!copyOne(job.srcPath, dst_path, err)) {
+                qWarning() << "Failed to copy files:" << QString::fromStdString(err.message());
+                qDebug() << "Source file:" << job.srcPath;
+                qDebug() << "Destination file:" << dst_path;
+                {
+                    QMutexLocker locker(&failedLock);
+                    m_failedPaths.append(dst_path);
+                }
+                emit copyFailed(job.relativePath);
+                continue;
+            }
+            copied++;
+            reportProgress(false);
+        }
+    };
+
+    int workerCount = m_workers > 0 ? m_workers : qBound(2, QThread::idealThreadCount(), 8);
+    QThreadPool pool;
+    pool.setMaxThreadCount(workerCount);
+    for (int i = 0; i < workerCount; i++)
+        pool.start(worker);
+
+    auto enqueue = [&](QString src_path, QString relative_path) {
+        if (m_matcher && (m_matcher->matches(relative_path) != m_whitelist))
+            return;
+        total++;
+        QMutexLocker locker(&queueLock);
+        while (queue.size() >= queueLimit)
+            notFull.wait(&queueLock);
+        queue.push_back({ std::move(src_path), std::move(relative_path) });
+        notEmpty.wakeOne();
+    };
+
+    // We can't use copy_opts::recursive because we need to take into account the
+    // blacklisted paths, so we iterate over the source directory, and if there's no blacklist
+    // match, we copy the file.
+    QDir src_dir(src);
+#ifdef Q_OS_WIN32
+    // one copied file per folder, to carry the folder attributes over once the files are in place
+    QHash<QString, QString> copiedFolders;
+#endif
+    QDirIterator source_it(src, QDir::Filter::Files | QDir::Filter::Hidden, QDirIterator::Subdirectories);
+    while (source_it.hasNext()) {
+        auto src_path = source_it.next();
+        auto relative_path = src_dir.relativeFilePath(src_path);
+#ifdef Q_OS_WIN32
+        if (!m_matcher || m_matcher->matches(relative_path) == m_whitelist)
+            copiedFolders.insert(source_it.fileInfo().path(), relative_path);
+#endif
+        enqueue(src_path, relative_path);
+    }
+
+    {
+        QMutexLocker locker(&queueLock);
+        walkDone = true;
+        notEmpty.wakeAll();
+    }
+    pool.waitForDone();
+
+#ifdef Q_OS_WIN32
+    for (const auto& relative_path : copiedFolders)
+        copyFolderAttributes(src, dst, relative_path);
+#endif
+
+    m_copied = copied.load();
+    reportProgress(true);
+    return m_failedPaths.isEmpty();
+}
+
 /**
  * @brief clone/reflink file from src to dst
  *
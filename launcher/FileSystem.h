@@ -522,6 +522,81 @@ class clone : public QObject {
     QList<QPair<QString, QString>> m_failedClones;
 };
 
+/**
+ * @brief Copies a directory and it's contents from src to dest using several worker threads
+ *
+ * Unlike copy/clone, the source tree is only walked once: the walk feeds a bounded queue that the workers drain,
+ * so no dry run is needed to count the files first. Progress is reported in batches while the walk is still going,
+ * with a total that grows as more files are found.
+ */
+class parallel_copy : public QObject {
+    Q_OBJECT
+   public:
+    parallel_copy(const QString& src, const QString& dst, QObject* parent = nullptr) : QObject(parent)
+    {
+        m_src.setPath(src);
+        m_dst.setPath(dst);
+    }
+    parallel_copy& followSymlinks(const bool follow)
+    {
+        m_followSymlinks = follow;
+        return *this;
+    }
+    parallel_copy& matcher(const IPathMatcher* filter)
+    {
+        m_matcher = filter;
+        return *this;
+    }
+    parallel_copy& whitelist(bool whitelist)
+    {
+        m_whitelist = whitelist;
+        return *this;
+    }
+    parallel_copy& overwrite(const bool overwrite)
+    {
+        m_overwrite = overwrite;
+        return *this;
+    }
+    /// only reflink/clone files, fail instead of falling back to a byte copy
+    parallel_copy& cloneOnly(const bool clone)
+    {
+        m_cloneOnly = clone;
+        return *this;
+    }
+    /// number of worker threads, 0 picks one based on the available cores
+    parallel_copy& workers(const int count)
+    {
+        m_workers = count;
+        return *this;
+    }
+
+    bool operator()();
+
+    qsizetype totalCopied() { return m_copied; }
+    qsizetype totalFailed() { return m_failedPaths.length(); }
+    QStringList failed() { return m_failedPaths; }
+
+   signals:
+    /// emitted from the worker threads, at most every few milliseconds and once at the end
+    void progress(qsizetype copied, qsizetype total);
+    void copyFailed(const QString& relativeName);
+
+   private:
+    bool copyOne(const QString& srcPath, const QString& dstPath, std::error_code& ec);
+
+   private:
+    bool m_followSymlinks = true;
+    const IPathMatcher* m_matcher = nullptr;
+    bool m_whitelist = false;
+    bool m_overwrite = false;
+    bool m_cloneOnly = false;
+    int m_workers = 0;
+    QDir m_src;
+    QDir m_dst;
+    qsizetype m_copied = 0;
+    QStringList m_failedPaths;
+};
+
 /**
  * @brief clone/reflink file from src to dst
  *
@@ -0,0 +1,416 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FileWatcher.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QPointer>
+#include <QTimer>
+
+#include "FileSystem.h"
+
+#ifdef Q_OS_LINUX
+#include <QSocketNotifier>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#else
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#endif
+
+namespace {
+// long enough to fold the burst of events a single save or extraction causes into one notification
+const int COALESCE_MS = 100;
+}  // namespace
+
+class FileWatcherService {
+   public:
+    FileWatcherService();
+    ~FileWatcherService();
+
+    static std::shared_ptr<FileWatcherService> get();
+
+    bool watch(FileWatcher* watcher, const QString& path, bool isDir);
+    void unwatch(FileWatcher* watcher, const QString& path);
+
+   private:
+    struct Watch {
+        QList<QPointer<FileWatcher>> watchers;
+        bool isDir;
+#ifdef Q_OS_LINUX
+        int wd = -1;
+#else
+        // entry name -> (size, mtime), diffed on every change to work out what happened
+        QHash<QString, QPair<qint64, qint64>> snapshot;
+#endif
+    };
+
+    bool addBackendWatch(const QString& path, Watch& watch);
+    void removeBackendWatch(const QString& path, Watch& watch);
+    void record(const QString& path, const QString& entry, FileWatcher::Change::Kind kind);
+    void flush();
+
+    QObject m_context;
+    QTimer m_flushTimer;
+    QHash<QString, Watch> m_watches;
+    // watched path -> changed entry -> what happened to it since the last flush
+    QHash<QString, QHash<QString, FileWatcher::Change::Kind>> m_pending;
+
+#ifdef Q_OS_LINUX
+    void readEvents();
+
+    int m_fd = -1;
+    QSocketNotifier* m_notifier = nullptr;
+    // one inotify watch is shared by all the paths that resolve to the same inode
+    QHash<int, QStringList> m_wds;
+#else
+    static QHash<QString, QPair<qint64, qint64>> scan(const QString& path);
+    void directoryChanged(const QString& path);
+
+    QFileSystemWatcher m_watcher;
+#endif
+};
+
+FileWatcherService::FileWatcherService()
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(COALESCE_MS);
+    QObject::connect(&m_flushTimer, &QTimer::timeout, &m_context, [this] { flush(); });
+
+#ifdef Q_OS_LINUX
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        qWarning() << "Failed to initialize inotify:" << strerror(errno);
+        return;
+    }
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, &m_context);
+    QObject::connect(m_notifier, &QSocketNotifier::activated, &m_context, [this] { readEvents(); });
+#else
+    QObject::connect(&m_watcher, &QFileSystemWatcher::directoryChanged, &m_context,
+                     [this](const QString& path) { directoryChanged(path); });
+    QObject::connect(&m_watcher, &QFileSystemWatcher::fileChanged, &m_context, [this](const QString& path) {
+        record(path, path, QFileInfo::exists(path) ? FileWatcher::Change::Modified : FileWatcher::Change::Removed);
+    });
+#endif
+}
+
+FileWatcherService::~FileWatcherService()
+{
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) {
+        delete m_notifier;
+        close(m_fd);
+    }
+#endif
+}
+
+std::shared_ptr<FileWatcherService> FileWatcherService::get()
+{
+    // lives as long as there is a FileWatcher using it
+    static std::weak_ptr<FileWatcherService> s_service;
+    auto service = s_service.lock();
+    if (!service) {
+        service = std::make_shared<FileWatcherService>();
+        s_service = service;
+    }
+    return service;
+}
+
+bool FileWatcherService::watch(FileWatcher* watcher, const QString& path, bool isDir)
+{
+    auto it = m_watches.find(path);
+    if (it == m_watches.end()) {
+        Watch watch;
+        watch.isDir = isDir;
+        if (!addBackendWatch(path, watch))
+            return false;
+        it = m_watches.insert(path, watch);
+    }
+#ifdef Q_OS_LINUX
+    // the kernel dropped the watch when the path went away, set it up again now that it's back
+    if (it->wd < 0 && !addBackendWatch(path, *it))
+        return false;
+#endif
+    it->watchers.append(watcher);
+    return true;
+}
+
+void FileWatcherService::unwatch(FileWatcher* watcher, const QString& path)
+{
+    auto it = m_watches.find(path);
+    if (it == m_watches.end())
+        return;
+    it->watchers.removeAll(watcher);
+    it->watchers.removeAll(nullptr);
+    if (!it->watchers.isEmpty())
+        return;
+    removeBackendWatch(path, *it);
+    m_watches.erase(it);
+    m_pending.remove(path);
+}
+
+void FileWatcherService::record(const QString& path, const QString& entry, FileWatcher::Change::Kind kind)
+{
+    using Kind = FileWatcher::Change::Kind;
+    auto& changes = m_pending[path];
+    auto it = changes.find(entry);
+    if (it == changes.end()) {
+        changes.insert(entry, kind);
+    } else if (*it == Kind::Created) {
+        // it didn't exist before this window, so either it still is new or nothing happened at all
+        if (kind == Kind::Removed)
+            changes.erase(it);
+    } else if (*it == Kind::Removed && kind == Kind::Created) {
+        // replaced, e.g. saved through a temporary file
+        *it = Kind::Modified;
+    } else {
+        *it = kind;
+    }
+
+    if (!m_flushTimer.isActive())
+        m_flushTimer.start();
+}
+
+void FileWatcherService::flush()
+{
+    auto pending = std::move(m_pending);
+    m_pending.clear();
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        auto& path = it.key();
+        if (it->isEmpty() || !m_watches.contains(path))
+            continue;
+
+        QList<FileWatcher::Change> changes;
+        changes.reserve(it->size());
+        for (auto change = it->cbegin(); change != it->cend(); ++change) {
+            changes.append({ change.value(), change.key() });
+        }
+
+        // copy, handlers are free to (un)watch paths
+        auto watchers = m_watches.value(path).watchers;
+        for (auto& watcher : watchers) {
+            if (watcher && m_watches.contains(path) && m_watches[path].watchers.contains(watcher))
+                watcher->notify(path, changes);
+        }
+    }
+}
+
+#ifdef Q_OS_LINUX
+bool FileWatcherService::addBackendWatch(const QString& path, Watch& watch)
+{
+    if (m_fd < 0)
+        return false;
+
+    // like QFileSystemWatcher, writes to the files in a directory don't change the directory
+    uint32_t mask = IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF;
+    if (watch.isDir)
+        mask |= IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+    else
+        mask |= IN_MODIFY | IN_CLOSE_WRITE;
+
+    watch.wd = inotify_add_watch(m_fd, QFile::encodeName(path).constData(), mask);
+    if (watch.wd < 0) {
+        qWarning() << "Failed to watch" << path << ":" << strerror(errno);
+        return false;
+    }
+    m_wds[watch.wd].append(path);
+    return true;
+}
+
+void FileWatcherService::removeBackendWatch(const QString& path, Watch& watch)
+{
+    if (watch.wd < 0)
+        return;
+    auto it = m_wds.find(watch.wd);
+    if (it == m_wds.end())
+        return;
+    it->removeAll(path);
+    if (it->isEmpty()) {
+        inotify_rm_watch(m_fd, watch.wd);
+        m_wds.erase(it);
+    }
+}
+
+void FileWatcherService::readEvents()
+{
+    using Kind = FileWatcher::Change::Kind;
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    for (;;) {
+        auto length = read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (char* ptr = buffer; ptr < buffer + length;) {
+            auto event = reinterpret_cast<const struct inotify_event*>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                qWarning() << "inotify queue overflowed, rescanning all watched paths";
+                for (auto it = m_watches.cbegin(); it != m_watches.cend(); ++it) {
+                    record(it.key(), it.key(), Kind::Modified);
+                }
+                continue;
+            }
+
+            auto paths = m_wds.value(event->wd);
+            for (auto& path : paths) {
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                    record(path, path, Kind::Removed);
+                } else if (event->len == 0) {
+                    record(path, path, Kind::Modified);
+                } else {
+                    auto entry = FS::PathCombine(path, QFile::decodeName(event->name));
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                        record(path, entry, Kind::Created);
+                    else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                        record(path, entry, Kind::Removed);
+                    else
+                        record(path, entry, Kind::Modified);
+                }
+            }
+
+            if (event->mask & IN_IGNORED) {
+                // the kernel dropped the watch, a later addPath on the same path will set it up again
+                for (auto& path : paths) {
+                    auto watch = m_watches.find(path);
+                    if (watch != m_watches.end())
+                        watch->wd = -1;
+                }
+                m_wds.remove(event->wd);
+            }
+        }
+    }
+}
+#else
+bool FileWatcherService::addBackendWatch(const QString& path, Watch& watch)
+{
+    if (!m_watcher.addPath(path))
+        return false;
+    if (watch.isDir)
+        watch.snapshot = scan(path);
+    return true;
+}
+
+void FileWatcherService::removeBackendWatch(const QString& path, [[maybe_unused]] Watch& watch)
+{
+    m_watcher.removePath(path);
+}
+
+QHash<QString, QPair<qint64, qint64>> FileWatcherService::scan(const QString& path)
+{
+    QHash<QString, QPair<qint64, qint64>> snapshot;
+    for (auto& info : QDir(path).entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System)) {
+        snapshot.insert(info.fileName(), { info.size(), info.lastModified().toMSecsSinceEpoch() });
+    }
+    return snapshot;
+}
+
+void FileWatcherService::directoryChanged(const QString& path)
+{
+    using Kind = FileWatcher::Change::Kind;
+    auto watch = m_watches.find(path);
+    if (watch == m_watches.end())
+        return;
+
+    if (!QFileInfo::exists(path)) {
+        watch->snapshot.clear();
+        record(path, path, Kind::Removed);
+        return;
+    }
+
+    auto current = scan(path);
+    for (auto it = current.cbegin(); it != current.cend(); ++it) {
+        auto old = watch->snapshot.constFind(it.key());
+        if (old == watch->snapshot.cend())
+            record(path, FS::PathCombine(path, it.key()), Kind::Created);
+        else if (*old != *it)
+            record(path, FS::PathCombine(path, it.key()), Kind::Modified);
+    }
+    for (auto it = watch->snapshot.cbegin(); it != watch->snapshot.cend(); ++it) {
+        if (!current.contains(it.key()))
+            record(path, FS::PathCombine(path, it.key()), Kind::Removed);
+    }
+    watch->snapshot = std::move(current);
+}
+#endif
+
+FileWatcher::FileWatcher(QObject* parent) : QObject(parent), m_service(FileWatcherService::get()) {}
+
+FileWatcher::~FileWatcher()
+{
+    removePaths(m_files + m_directories);
+}
+
+bool FileWatcher::addPath(const QString& path)
+{
+    if (path.isEmpty() || m_files.contains(path) || m_directories.contains(path))
+        return false;
+    QFileInfo info(path);
+    if (!info.exists())
+        return false;
+    if (!m_service->watch(this, path, info.isDir()))
+        return false;
+    if (info.isDir())
+        m_directories.append(path);
+    else
+        m_files.append(path);
+    return true;
+}
+
+QStringList FileWatcher::addPaths(const QStringList& paths)
+{
+    QStringList failed;
+    for (auto& path : paths) {
+        if (!addPath(path))
+            failed.append(path);
+    }
+    return failed;
+}
+
+bool FileWatcher::removePath(const QString& path)
+{
+    if (!m_files.removeOne(path) && !m_directories.removeOne(path))
+        return false;
+    m_service->unwatch(this, path);
+    return true;
+}
+
+QStringList FileWatcher::removePaths(const QStringList& paths)
+{
+    QStringList failed;
+    for (auto& path : paths) {
+        if (!removePath(path))
+            failed.append(path);
+    }
+    return failed;
+}
+
+void FileWatcher::notify(const QString& path, const QList<Change>& changes)
+{
+    emit changed(path, changes);
+    if (m_directories.contains(path))
+        emit directoryChanged(path);
+    else if (m_files.contains(path))
+        emit fileChanged(path);
+}
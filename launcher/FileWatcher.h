@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+class FileWatcherService;
+
+/** Drop-in replacement for QFileSystemWatcher.
+ *
+ *  All instances share a single watcher (inotify on Linux), so the same path watched by several models costs one
+ *  watch. Changes are coalesced over a short window and reported once per watched path, along with what changed.
+ *  Must only be used from the GUI thread.
+ */
+class FileWatcher : public QObject {
+    Q_OBJECT
+   public:
+    struct Change {
+        enum Kind { Created, Removed, Modified };
+        Kind kind;
+        /// Absolute path of the changed entry. The watched path itself means "something changed", rescan it.
+        QString path;
+
+        bool operator==(const Change& other) const { return kind == other.kind && path == other.path; }
+    };
+
+    explicit FileWatcher(QObject* parent = nullptr);
+    ~FileWatcher() override;
+
+    bool addPath(const QString& path);
+    QStringList addPaths(const QStringList& paths);
+    bool removePath(const QString& path);
+    QStringList removePaths(const QStringList& paths);
+
+    QStringList files() const { return m_files; }
+    QStringList directories() const { return m_directories; }
+
+   signals:
+    /// Emitted before directoryChanged / fileChanged with the coalesced changes to the watched path
+    void changed(const QString& path, const QList<FileWatcher::Change>& changes);
+    void directoryChanged(const QString& path);
+    void fileChanged(const QString& path);
+
+   private:
+    friend class FileWatcherService;
+    void notify(const QString& path, const QList<Change>& changes);
+
+    std::shared_ptr<FileWatcherService> m_service;
+    QStringList m_files;
+    QStringList m_directories;
+};
+
+Q_DECLARE_METATYPE(FileWatcher::Change)
@@ -37,6 +37,8 @@
 #include <zlib.h>
 #include <QByteArray>
 
+#include <cstring>
+
 bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes)
 {
     if (compressedBytes.size() == 0) {
@@ -136,3 +138,151 @@ bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
     }
     return true;
 }
+
+static const int GZIP_BUFFER_SIZE = 64 * 1024;
+// zlib counts in uInt, so large reads and writes are fed to it in slices
+static const qint64 GZIP_MAX_SLICE = 1 << 30;
+
+GZipDevice::GZipDevice(QIODevice* device, int level, QObject* parent)
+    : QIODevice(parent), m_device(device), m_level(level), m_stream(new z_stream)
+{
+    memset(m_stream.get(), 0, sizeof(z_stream));
+}
+
+GZipDevice::~GZipDevice()
+{
+    close();
+}
+
+bool GZipDevice::open(OpenMode mode)
+{
+    auto direction = mode & ReadWrite;
+    if (direction != ReadOnly && direction != WriteOnly) {
+        setErrorString(tr("A gzip stream can only be opened for reading or for writing"));
+        return false;
+    }
+    if (!m_device->isOpen() && !m_device->open(direction)) {
+        setErrorString(m_device->errorString());
+        return false;
+    }
+
+    memset(m_stream.get(), 0, sizeof(z_stream));
+    int err;
+    if (direction == ReadOnly) {
+        err = inflateInit2(m_stream.get(), 16 + MAX_WBITS);
+    } else {
+        err = deflateInit2(m_stream.get(), m_level, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    }
+    if (err != Z_OK) {
+        setErrorString(tr("Could not initialize zlib"));
+        return false;
+    }
+    m_buffer.resize(GZIP_BUFFER_SIZE);
+    m_streamEnd = false;
+    m_finished = false;
+    return QIODevice::open(direction);
+}
+
+bool GZipDevice::finish()
+{
+    if (!isOpen() || m_finished)
+        return true;
+    m_finished = true;
+    if (openMode() & ReadOnly) {
+        inflateEnd(m_stream.get());
+        return true;
+    }
+    m_stream->next_in = nullptr;
+    m_stream->avail_in = 0;
+    bool ok = writeOutput(Z_FINISH);
+    deflateEnd(m_stream.get());
+    return ok;
+}
+
+void GZipDevice::close()
+{
+    if (!isOpen())
+        return;
+    finish();
+    QIODevice::close();
+}
+
+bool GZipDevice::atEnd() const
+{
+    return m_streamEnd && QIODevice::atEnd();
+}
+
+qint64 GZipDevice::readData(char* data, qint64 maxSize)
+{
+    if (m_streamEnd || m_finished)
+        return m_streamEnd ? 0 : -1;
+
+    auto requested = static_cast<uInt>(qMin(maxSize, GZIP_MAX_SLICE));
+    m_stream->next_out = reinterpret_cast<Bytef*>(data);
+    m_stream->avail_out = requested;
+    while (m_stream->avail_out == requested) {
+        if (m_stream->avail_in == 0) {
+            auto count = m_device->read(m_buffer.data(), m_buffer.size());
+            if (count < 0) {
+                setErrorString(m_device->errorString());
+                return -1;
+            }
+            if (count == 0) {
+                // a sequential device may simply not have more data yet
+                if (m_device->isSequential() && !m_device->atEnd())
+                    break;
+                setErrorString(tr("Unexpected end of gzip stream"));
+                return -1;
+            }
+            m_stream->next_in = reinterpret_cast<Bytef*>(m_buffer.data());
+            m_stream->avail_in = static_cast<uInt>(count);
+        }
+        auto err = inflate(m_stream.get(), Z_NO_FLUSH);
+        if (err == Z_STREAM_END) {
+            m_streamEnd = true;
+            break;
+        }
+        if (err != Z_OK && err != Z_BUF_ERROR) {
+            setErrorString(m_stream->msg ? QString::fromUtf8(m_stream->msg) : tr("Corrupt gzip stream"));
+            return -1;
+        }
+    }
+    return requested - m_stream->avail_out;
+}
+
+qint64 GZipDevice::writeData(const char* data, qint64 maxSize)
+{
+    if (m_finished)
+        return -1;
+
+    qint64 written = 0;
+    while (written < maxSize) {
+        auto slice = static_cast<uInt>(qMin(maxSize - written, GZIP_MAX_SLICE));
+        m_stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data + written));
+        m_stream->avail_in = slice;
+        if (!writeOutput(Z_NO_FLUSH))
+            return -1;
+        written += slice;
+    }
+    return written;
+}
+
+bool GZipDevice::writeOutput(int flush)
+{
+    int err;
+    do {
+        m_stream->next_out = reinterpret_cast<Bytef*>(m_buffer.data());
+        m_stream->avail_out = static_cast<uInt>(m_buffer.size());
+        err = deflate(m_stream.get(), flush);
+        if (err == Z_STREAM_ERROR) {
+            setErrorString(tr("Corrupt gzip stream"));
+            return false;
+        }
+        auto produced = m_buffer.size() - m_stream->avail_out;
+        if (produced > 0 && m_device->write(m_buffer.constData(), produced) != produced) {
+            setErrorString(m_device->errorString());
+            return false;
+        }
+    } while (m_stream->avail_out == 0 || (flush == Z_FINISH && err != Z_STREAM_END));
+    return true;
+}
@@ -1,8 +1,51 @@
 #pragma once
 #include <QByteArray>
+#include <QIODevice>
+
+#include <memory>
+
+struct z_stream_s;
 
 class GZip {
    public:
     static bool unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes);
     static bool zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes);
 };
+
+/** Streams gzip data through another device.
+ *
+ *  Opened ReadOnly it inflates what it reads from the underlying device, opened WriteOnly it deflates what is
+ *  written to it into the underlying device. Memory use is bounded by the internal buffers, however large the
+ *  stream is. The underlying device is not owned and is opened in the same mode if it is not open yet.
+ */
+class GZipDevice : public QIODevice {
+    Q_OBJECT
+   public:
+    /// 'level' is the zlib compression level used when writing, -1 picks zlib's default
+    explicit GZipDevice(QIODevice* device, int level = -1, QObject* parent = nullptr);
+    ~GZipDevice() override;
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+    bool atEnd() const override;
+
+    /// Writes the end of the gzip stream, returns false if the underlying device did not take all of it.
+    /// Called by close(), call it first when the result matters.
+    bool finish();
+
+   protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+   private:
+    bool writeOutput(int flush);
+
+   private:
+    QIODevice* m_device;
+    int m_level;
+    std::unique_ptr<z_stream_s> m_stream;
+    QByteArray m_buffer;
+    bool m_streamEnd = false;
+    bool m_finished = false;
+};
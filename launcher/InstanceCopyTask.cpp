@@ -4,7 +4,7 @@
 #include <memory>
 #include "FileSystem.h"
 #include "NullInstance.h"
-#include "pathmatcher/RegexpMatcher.h"
+#include "pathmatcher/CompiledMatcher.h"
 #include "settings/INISettingsObject.h"
 #include "tasks/Task.h"
 
@@ -30,8 +30,8 @@ InstanceCopyTask::InstanceCopyTask(InstancePtr origInstance, const InstanceCopyP
     if (!filters.isEmpty()) {
         // Set regex filter:
         // FIXME: get this from the original instance type...
-        auto matcherReal = new RegexpMatcher(filters);
-        matcherReal->caseSensitive(false);
+        auto matcherReal = new CompiledMatcher();
+        matcherReal->addRegexp(filters, Qt::CaseSensitive);
         m_matcher.reset(matcherReal);
     }
 }
@@ -39,20 +39,19 @@ InstanceCopyTask::InstanceCopyTask(InstancePtr origInstance, const InstanceCopyP
 void InstanceCopyTask::executeTask()
 {
     setStatus(tr("Copying instance %1").arg(m_origInstance->name()));
+    // make sure the copy sees the latest instance.cfg
+    SettingsObject::flushAll();
 
     m_copyFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this] {
         if (m_useClone) {
-            FS::clone folderClone(m_origInstance->instanceRoot(), m_stagingPath);
-            folderClone.matcher(m_matcher.get());
+            FS::parallel_copy folderClone(m_origInstance->instanceRoot(), m_stagingPath);
+            folderClone.cloneOnly(true).matcher(m_matcher.get());
 
-            folderClone(true);
-            setProgress(0, folderClone.totalCloned());
-            connect(&folderClone, &FS::clone::fileCloned,
-                    [this](QString src, QString dst) { setProgress(m_progress + 1, m_progressTotal); });
+            connect(&folderClone, &FS::parallel_copy::progress, [this](qsizetype copied, qsizetype total) { setProgress(copied, total); });
             return folderClone();
         }
         if (m_useLinks || m_useHardLinks) {
-            std::unique_ptr<FS::copy> savesCopy;
+            std::unique_ptr<FS::parallel_copy> savesCopy;
             if (m_copySaves) {
                 QFileInfo mcDir(FS::PathCombine(m_stagingPath, "minecraft"));
                 QFileInfo dotMCDir(FS::PathCombine(m_stagingPath, ".minecraft"));
@@ -63,23 +62,26 @@ void InstanceCopyTask::executeTask()
                 else
                     staging_mc_dir = mcDir.filePath();
 
-                savesCopy = std::make_unique<FS::copy>(FS::PathCombine(m_origInstance->gameRoot(), "saves"),
-                                                       FS::PathCombine(staging_mc_dir, "saves"));
+                savesCopy = std::make_unique<FS::parallel_copy>(FS::PathCombine(m_origInstance->gameRoot(), "saves"),
+                                                                FS::PathCombine(staging_mc_dir, "saves"));
                 savesCopy->followSymlinks(true);
-                (*savesCopy)(true);
-                setProgress(0, savesCopy->totalCopied());
-                connect(savesCopy.get(), &FS::copy::fileCopied, [this](QString src) { setProgress(m_progress + 1, m_progressTotal); });
             }
             FS::create_link folderLink(m_origInstance->instanceRoot(), m_stagingPath);
             int depth = m_linkRecursively ? -1 : 0;  // we need to at least link the top level instead of the instance folder
             folderLink.linkRecursively(true).setMaxDepth(depth).useHardLinks(m_useHardLinks).matcher(m_matcher.get());
 
             folderLink(true);
-            setProgress(0, m_progressTotal + folderLink.totalToLink());
-            connect(&folderLink, &FS::create_link::fileLinked,
-                    [this](QString src, QString dst) { setProgress(m_progress + 1, m_progressTotal); });
+            setProgress(0, folderLink.totalToLink());
+            connect(&folderLink, &FS::create_link::fileLinked, [this](QString src, QString dst) { advanceProgress(); });
             bool there_were_errors = false;
 
+            if (savesCopy) {
+                // the saves are copied after linking, their progress goes on top of the links
+                connect(savesCopy.get(), &FS::parallel_copy::progress, [this, &folderLink](qsizetype copied, qsizetype total) {
+                    setProgress(folderLink.totalToLink() + copied, folderLink.totalToLink() + total);
+                });
+            }
+
             if (!folderLink()) {
 #if defined Q_OS_WIN32
                 if (!m_useHardLinks) {
@@ -126,12 +128,10 @@ void InstanceCopyTask::executeTask()
 
             return !there_were_errors;
         }
-        FS::copy folderCopy(m_origInstance->instanceRoot(), m_stagingPath);
+        FS::parallel_copy folderCopy(m_origInstance->instanceRoot(), m_stagingPath);
         folderCopy.followSymlinks(false).matcher(m_matcher.get());
 
-        folderCopy(true);
-        setProgress(0, folderCopy.totalCopied());
-        connect(&folderCopy, &FS::copy::fileCopied, [this](QString src) { setProgress(m_progress + 1, m_progressTotal); });
+        connect(&folderCopy, &FS::parallel_copy::progress, [this](qsizetype copied, qsizetype total) { setProgress(copied, total); });
         return folderCopy();
     });
     connect(&m_copyFutureWatcher, &QFutureWatcher<bool>::finished, this, &InstanceCopyTask::copyFinished);
@@ -37,9 +37,9 @@
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
-#include <QFileSystemWatcher>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QMimeData>
@@ -51,10 +51,12 @@
 #include <QTimer>
 #include <QUuid>
 #include <QXmlStreamReader>
+#include <QtConcurrent>
 
 #include "BaseInstance.h"
 #include "ExponentialSeries.h"
 #include "FileSystem.h"
+#include "FileWatcher.h"
 #include "InstanceList.h"
 #include "InstanceTask.h"
 #include "NullInstance.h"
@@ -67,6 +69,7 @@
 #endif
 
 const static int GROUP_FILE_FORMAT_VERSION = 1;
+const static int INDEX_FILE_FORMAT_VERSION = 1;
 
 InstanceList::InstanceList(SettingsObjectPtr settings, const QString& instDir, QObject* parent)
     : QAbstractListModel(parent), m_globalSettings(settings)
@@ -81,8 +84,8 @@ InstanceList::InstanceList(SettingsObjectPtr settings, const QString& instDir, Q
 
     // NOTE: canonicalPath requires the path to exist. Do not move this above the creation block!
     m_instDir = QDir(instDir).canonicalPath();
-    m_watcher = new QFileSystemWatcher(this);
-    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &InstanceList::instanceDirContentsChanged);
+    m_watcher = new FileWatcher(this);
+    connect(m_watcher, &FileWatcher::directoryChanged, this, &InstanceList::instanceDirContentsChanged);
     m_watcher->addPath(m_instDir);
 }
 
@@ -177,6 +180,9 @@ QVariant InstanceList::data(const QModelIndex& index, int role) const
         case InstanceIDRole: {
             return pdata->id();
         }
+        case LastLaunchRole: {
+            return pdata->lastLaunch();
+        }
         case Qt::EditRole:
         case Qt::DisplayRole: {
             return pdata->name();
@@ -347,10 +353,14 @@ bool InstanceList::trashInstance(const InstanceId& id)
         saveGroupList();
     }
 
+    // the trashed copy gets the latest settings, so undoing brings them back
+    SettingsObject::flushAll();
     if (!FS::trash(inst->instanceRoot(), &trashedLoc)) {
         qDebug() << "Trash of instance" << id << "has not been completely successfully...";
         return false;
     }
+    // a later save would bring the instance folder back
+    inst->settings()->discardChanges();
 
     qDebug() << "Instance" << id << "has been trashed by the launcher.";
     m_trashHistory.push({ id, inst->instanceRoot(), trashedLoc, cachedGroupId });
@@ -403,6 +413,8 @@ void InstanceList::deleteInstance(const InstanceId& id)
     }
 
     qDebug() << "Will delete instance" << id;
+    // a pending or later save would bring the instance folder back
+    inst->settings()->discardChanges();
     if (!FS::deletePath(inst->instanceRoot())) {
         qWarning() << "Deletion of instance" << id << "has not been completely successful ...";
         return;
@@ -429,23 +441,36 @@ static QMap<InstanceId, InstanceLocator> getIdMapping(const QList<InstancePtr>&
 QList<InstanceId> InstanceList::discoverInstances()
 {
     qDebug() << "Discovering instances in" << m_instDir;
-    QList<InstanceId> out;
+    QElapsedTimer timer;
+    timer.start();
+
+    QStringList subDirs;
     QDirIterator iter(m_instDir, QDir::Dirs | QDir::NoDot | QDir::NoDotDot | QDir::Readable | QDir::Hidden, QDirIterator::FollowSymlinks);
     while (iter.hasNext()) {
-        QString subDir = iter.next();
-        QFileInfo dirInfo(subDir);
+        subDirs.append(iter.next());
+    }
+
+    // the stat calls are what is slow on network storage, so run them on the pool
+    const auto instDirPath = QFileInfo(m_instDir).canonicalFilePath();
+    std::function<bool(const QString&)> isInstance = [instDirPath](const QString& subDir) {
         if (!QFileInfo(FS::PathCombine(subDir, "instance.cfg")).exists())
-            continue;
+            return false;
         // if it is a symlink, ignore it if it goes to the instance folder
+        QFileInfo dirInfo(subDir);
         if (dirInfo.isSymLink()) {
             QFileInfo targetInfo(dirInfo.symLinkTarget());
-            QFileInfo instDirInfo(m_instDir);
-            if (targetInfo.canonicalPath() == instDirInfo.canonicalFilePath()) {
+            if (targetInfo.canonicalPath() == instDirPath) {
                 qDebug() << "Ignoring symlink" << subDir << "that leads into the instances folder";
-                continue;
+                return false;
             }
         }
-        auto id = dirInfo.fileName();
+        return true;
+    };
+    const auto instanceDirs = QtConcurrent::blockingFiltered(subDirs, isInstance);
+
+    QList<InstanceId> out;
+    for (auto& subDir : instanceDirs) {
+        auto id = QFileInfo(subDir).fileName();
         out.append(id);
         qDebug() << "Found instance ID" << id;
     }
@@ -455,6 +480,7 @@ QList<InstanceId> InstanceList::discoverInstances()
     instanceSet = out.toSet();
 #endif
     m_instancesProbed = true;
+    qDebug() << "Discovered" << out.size() << "instances in" << timer.elapsed() << "ms";
     return out;
 }
 
@@ -463,6 +489,7 @@ InstanceList::InstListError InstanceList::loadList()
     auto existingIds = getIdMapping(m_instances);
 
     QList<InstancePtr> newList;
+    QList<InstanceId> newIds;
 
     for (auto& id : discoverInstances()) {
         if (existingIds.contains(id)) {
@@ -470,11 +497,26 @@ InstanceList::InstListError InstanceList::loadList()
             existingIds.remove(id);
             qDebug() << "Should keep and soft-reload" << id;
         } else {
-            InstancePtr instPtr = loadInstance(id);
+            newIds.append(id);
+        }
+    }
+
+    if (!newIds.isEmpty()) {
+        auto configs = loadInstanceConfigs(newIds);
+
+        if (!m_groupsLoaded) {
+            loadGroupList();
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        for (auto& id : newIds) {
+            InstancePtr instPtr = loadInstance(id, configs.value(id));
             if (instPtr) {
                 newList.append(instPtr);
             }
         }
+        qDebug() << "Constructed" << newList.size() << "instances in" << timer.elapsed() << "ms";
     }
 
     // TODO: looks like a general algorithm with a few specifics inserted. Do something about it.
@@ -612,23 +654,45 @@ int InstanceList::getInstIndex(BaseInstance* inst) const
     return -1;
 }
 
-void InstanceList::propertiesChanged(BaseInstance* inst)
+void InstanceList::propertiesChanged(BaseInstance* inst, BaseInstance::Property property)
 {
     int i = getInstIndex(inst);
-    if (i != -1) {
-        emit dataChanged(index(i), index(i));
-        updateTotalPlayTime();
+    if (i == -1)
+        return;
+
+    // only a rename can move the item or change its size, the rest is repainted in place
+    switch (property) {
+        case BaseInstance::Property::Name:
+            emit dataChanged(index(i), index(i));
+            break;
+        case BaseInstance::Property::Icon:
+            emit dataChanged(index(i), index(i), { Qt::DecorationRole });
+            break;
+        case BaseInstance::Property::LastLaunch:
+            emit dataChanged(index(i), index(i), { LastLaunchRole });
+            break;
+        case BaseInstance::Property::State:
+            emit dataChanged(index(i), index(i), { InstancePointerRole });
+            break;
     }
+    updateTotalPlayTime();
 }
 
 InstancePtr InstanceList::loadInstance(const InstanceId& id)
+{
+    INIFile config;
+    config.loadFile(FS::PathCombine(m_instDir, id, "instance.cfg"));
+    return loadInstance(id, config);
+}
+
+InstancePtr InstanceList::loadInstance(const InstanceId& id, const INIFile& config)
 {
     if (!m_groupsLoaded) {
         loadGroupList();
     }
 
     auto instanceRoot = FS::PathCombine(m_instDir, id);
-    auto instanceSettings = std::make_shared<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"));
+    auto instanceSettings = std::make_shared<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"), config);
     InstancePtr inst;
 
     instanceSettings->registerSetting("InstanceType", "");
@@ -646,6 +710,130 @@ InstancePtr InstanceList::loadInstance(const InstanceId& id)
     return inst;
 }
 
+namespace {
+struct IndexedConfig {
+    InstanceId id;
+    qint64 size = 0;
+    qint64 modified = 0;
+    INIFile config;
+    bool fromIndex = false;
+};
+
+QString indexFilePath()
+{
+    return QDir("cache").absoluteFilePath("instances.json");
+}
+
+// only plain strings and string lists survive a round trip through JSON, anything else makes the entry uncacheable
+bool configToJson(const INIFile& config, QJsonObject& out)
+{
+    for (auto iter = config.begin(); iter != config.end(); iter++) {
+        auto& value = iter.value();
+        if (value.userType() == QMetaType::QString) {
+            out.insert(iter.key(), value.toString());
+        } else if (value.userType() == QMetaType::QStringList) {
+            out.insert(iter.key(), QJsonArray::fromStringList(value.toStringList()));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+INIFile configFromJson(const QJsonObject& obj)
+{
+    INIFile config;
+    for (auto iter = obj.begin(); iter != obj.end(); iter++) {
+        if (iter.value().isArray()) {
+            QStringList list;
+            for (auto item : iter.value().toArray())
+                list.append(item.toString());
+            config.insert(iter.key(), list);
+        } else {
+            config.insert(iter.key(), iter.value().toString());
+        }
+    }
+    return config;
+}
+}  // namespace
+
+QHash<InstanceId, INIFile> InstanceList::loadInstanceConfigs(const QList<InstanceId>& ids)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QJsonObject indexed;
+    if (QFileInfo::exists(indexFilePath())) {
+        try {
+            auto root = QJsonDocument::fromJson(FS::read(indexFilePath())).object();
+            if (root.value("formatVersion").toInt() == INDEX_FILE_FORMAT_VERSION && root.value("instDir").toString() == m_instDir)
+                indexed = root.value("instances").toObject();
+        } catch (const FS::FileSystemException& e) {
+            qWarning() << "Failed to read instance index:" << e.cause();
+        }
+    }
+
+    // entries are matched on the size and mtime of instance.cfg, so anything touched since the last run is parsed again
+    std::function<IndexedConfig(const InstanceId&)> load = [this, &indexed](const InstanceId& id) {
+        IndexedConfig result;
+        result.id = id;
+        auto path = FS::PathCombine(m_instDir, id, "instance.cfg");
+        QFileInfo info(path);
+        result.size = info.size();
+        result.modified = info.lastModified().toMSecsSinceEpoch();
+
+        auto entry = indexed.value(id).toObject();
+        if (!entry.isEmpty() && entry.value("size").toVariant().toLongLong() == result.size &&
+            entry.value("modified").toVariant().toLongLong() == result.modified) {
+            result.config = configFromJson(entry.value("config").toObject());
+            result.fromIndex = true;
+        } else {
+            result.config.loadFile(path);
+        }
+        return result;
+    };
+    const auto results = QtConcurrent::blockingMapped<QList<IndexedConfig>>(ids, load);
+
+    QHash<InstanceId, INIFile> out;
+    QJsonObject instances;
+    int hits = 0;
+    for (auto& result : results) {
+        out.insert(result.id, result.config);
+        if (result.fromIndex) {
+            hits++;
+            instances.insert(result.id, indexed.value(result.id));
+            continue;
+        }
+        QJsonObject config;
+        if (!configToJson(result.config, config))
+            continue;
+        QJsonObject entry;
+        entry.insert("size", result.size);
+        entry.insert("modified", result.modified);
+        entry.insert("config", config);
+        instances.insert(result.id, entry);
+    }
+    qDebug() << "Loaded" << results.size() << "instance configs (" << hits << "from index) in" << timer.elapsed() << "ms";
+
+    // instances that are already loaded stay in the index so a partial reload does not evict them
+    for (auto iter = indexed.begin(); iter != indexed.end(); iter++) {
+        if (!instances.contains(iter.key()) && instanceSet.contains(iter.key()))
+            instances.insert(iter.key(), iter.value());
+    }
+    if (instances != indexed) {
+        QJsonObject root;
+        root.insert("formatVersion", INDEX_FILE_FORMAT_VERSION);
+        root.insert("instDir", m_instDir);
+        root.insert("instances", instances);
+        try {
+            FS::write(indexFilePath(), QJsonDocument(root).toJson(QJsonDocument::Compact));
+        } catch (const FS::FileSystemException& e) {
+            qWarning() << "Failed to write instance index:" << e.cause();
+        }
+    }
+    return out;
+}
+
 void InstanceList::increaseGroupCount(const QString& group)
 {
     if (group.isEmpty())
@@ -988,6 +1176,9 @@ bool InstanceList::commitStagedInstance(const QString& path,
     if (groupName.isEmpty() && !groupName.isNull())
         groupName = QString();
 
+    // the staged instance.cfg may still have a write queued
+    SettingsObject::flushAll();
+
     QString instID;
     InstancePtr inst;
 
@@ -36,6 +36,7 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QPair>
@@ -43,8 +44,9 @@
 #include <QStack>
 
 #include "BaseInstance.h"
+#include "settings/INIFile.h"
 
-class QFileSystemWatcher;
+class FileWatcher;
 class InstanceTask;
 struct InstanceName;
 
@@ -81,7 +83,8 @@ class InstanceList : public QAbstractListModel {
     enum AdditionalRoles {
         GroupRole = Qt::UserRole,
         InstancePointerRole = 0x34B1CB48,  ///< Return pointer to real instance
-        InstanceIDRole = 0x34B1CB49        ///< Return id if the instance
+        InstanceIDRole = 0x34B1CB49,       ///< Return id if the instance
+        LastLaunchRole = 0x34B1CB4A        ///< Return when the instance was last launched
     };
     /*!
      * \brief Error codes returned by functions in the InstanceList class.
@@ -164,7 +167,7 @@ class InstanceList : public QAbstractListModel {
     void on_GroupStateChanged(const QString& group, bool collapsed);
 
    private slots:
-    void propertiesChanged(BaseInstance* inst);
+    void propertiesChanged(BaseInstance* inst, BaseInstance::Property property);
     void providerUpdated();
     void instanceDirContentsChanged(const QString& path);
 
@@ -178,6 +181,8 @@ class InstanceList : public QAbstractListModel {
     void saveGroupList();
     QList<InstanceId> discoverInstances();
     InstancePtr loadInstance(const InstanceId& id);
+    InstancePtr loadInstance(const InstanceId& id, const INIFile& config);
+    QHash<InstanceId, INIFile> loadInstanceConfigs(const QList<InstanceId>& ids);
 
     void increaseGroupCount(const QString& group);
     void decreaseGroupCount(const QString& group);
@@ -192,7 +197,7 @@ class InstanceList : public QAbstractListModel {
 
     SettingsObjectPtr m_globalSettings;
     QString m_instDir;
-    QFileSystemWatcher* m_watcher;
+    FileWatcher* m_watcher;
     // FIXME: this is so inefficient that looking at it is almost painful.
     QSet<QString> m_collapsedGroups;
     QMap<InstanceId, GroupId> m_instanceGroupIndex;
@@ -70,14 +70,23 @@ bool mergeZipFiles(QuaZip* into, QFileInfo from, QSet<QString>& contained, const
         }
         contained.insert(filename);
 
-        if (!fileInsideMod.open(QIODevice::ReadOnly)) {
+        QuaZipFileInfo64 info;
+        if (!modZip.getCurrentFileInfo(&info)) {
+            qCritical() << "Failed to read info of " << filename << " from " << from.fileName();
+            return false;
+        }
+
+        // copy the compressed stream as-is, the entry keeps its method, crc and sizes
+        int method = 0;
+        int level = 0;
+        if (!fileInsideMod.open(QIODevice::ReadOnly, &method, &level, true)) {
             qCritical() << "Failed to open " << filename << " from " << from.fileName();
             return false;
         }
 
-        QuaZipNewInfo info_out(fileInsideMod.getActualFileName());
+        QuaZipNewInfo info_out(info);
 
-        if (!zipOutFile.open(QIODevice::WriteOnly, info_out)) {
+        if (!zipOutFile.open(QIODevice::WriteOnly, info_out, nullptr, info.crc, method, level, true)) {
             qCritical() << "Failed to open " << filename << " in the jar";
             fileInsideMod.close();
             return false;
@@ -490,7 +499,7 @@ auto ExportToZipTask::exportZip() -> ZipResult
         auto absolute = file.absoluteFilePath();
         auto relative = m_dir.relativeFilePath(absolute);
         setStatus("Compressing: " + relative);
-        setProgress(m_progress + 1, m_progressTotal);
+        advanceProgress();
         if (m_follow_symlinks) {
             if (file.isSymLink())
                 absolute = file.symLinkTarget();
@@ -570,7 +579,7 @@ auto ExtractZipTask::extractZip() -> ZipResult
     do {
         if (m_zip_future.isCanceled())
             return ZipResult();
-        setProgress(m_progress + 1, m_progressTotal);
+        advanceProgress();
         QString file_name = m_input->getCurrentFileName();
         if (!file_name.startsWith(m_subdirectory))
             continue;
@@ -59,6 +59,7 @@ using FilterFunction = std::function<bool(const QString&)>;
 
 /**
  * Merge two zip files, using a filter function
+ * Entries are copied in their compressed form, without being inflated and deflated again
  */
 bool mergeZipFiles(QuaZip* into, QFileInfo from, QSet<QString>& contained, const FilterFunction& filter = nullptr);
 
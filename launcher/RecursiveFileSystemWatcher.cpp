@@ -3,10 +3,12 @@
 #include <QDebug>
 #include <QRegularExpression>
 
-RecursiveFileSystemWatcher::RecursiveFileSystemWatcher(QObject* parent) : QObject(parent), m_watcher(new QFileSystemWatcher(this))
+#include <algorithm>
+
+RecursiveFileSystemWatcher::RecursiveFileSystemWatcher(QObject* parent) : QObject(parent), m_watcher(new FileWatcher(this))
 {
-    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &RecursiveFileSystemWatcher::fileChange);
-    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &RecursiveFileSystemWatcher::directoryChange);
+    connect(m_watcher, &FileWatcher::fileChanged, this, &RecursiveFileSystemWatcher::fileChange);
+    connect(m_watcher, &FileWatcher::changed, this, &RecursiveFileSystemWatcher::directoryChange);
 }
 
 void RecursiveFileSystemWatcher::setRootDir(const QDir& root)
@@ -68,6 +70,17 @@ void RecursiveFileSystemWatcher::addFilesToWatcherRecursive(const QDir& dir)
         }
     }
 }
+void RecursiveFileSystemWatcher::removeFromWatcherRecursive(const QString& path)
+{
+    auto prefix = path + '/';
+    QStringList remove;
+    for (auto& watched : m_watcher->directories() + m_watcher->files()) {
+        if (watched == path || watched.startsWith(prefix))
+            remove.append(watched);
+    }
+    m_watcher->removePaths(remove);
+}
+
 QStringList RecursiveFileSystemWatcher::scanRecursive(const QDir& directory)
 {
     QStringList ret;
@@ -90,7 +103,62 @@ void RecursiveFileSystemWatcher::fileChange(const QString& path)
 {
     emit fileChanged(path);
 }
-void RecursiveFileSystemWatcher::directoryChange([[maybe_unused]] const QString& path)
+void RecursiveFileSystemWatcher::directoryChange(const QString& path, const QList<FileWatcher::Change>& changes)
 {
-    setFiles(scanRecursive(m_root));
+    // file contents are reported through fileChanged
+    if (!m_watcher->directories().contains(path))
+        return;
+
+    // apply what changed instead of scanning the whole tree again
+    auto files = m_files;
+    for (auto& change : changes) {
+        if (change.path == path) {
+            // the watcher couldn't tell what changed
+            setFiles(scanRecursive(m_root));
+            return;
+        }
+
+        auto relPath = m_root.relativeFilePath(change.path);
+        switch (change.kind) {
+            case FileWatcher::Change::Created: {
+                QFileInfo info(change.path);
+                if (info.isDir()) {
+                    if (m_isEnabled)
+                        addFilesToWatcherRecursive(change.path);
+                    // the directory may have been moved out and back in since the last scan
+                    for (auto& file : scanRecursive(change.path)) {
+                        if (!files.contains(file))
+                            files.append(file);
+                    }
+                } else if (m_matcher && m_matcher->matches(relPath) && !files.contains(relPath)) {
+                    files.append(relPath);
+                    if (m_isEnabled && m_watchFiles)
+                        m_watcher->addPath(change.path);
+                }
+                break;
+            }
+            case FileWatcher::Change::Removed: {
+                removeFromWatcherRecursive(change.path);
+                auto prefix = relPath + '/';
+                files.erase(std::remove_if(files.begin(), files.end(),
+                                           [&relPath, &prefix](const QString& file) { return file == relPath || file.startsWith(prefix); }),
+                            files.end());
+                break;
+            }
+            case FileWatcher::Change::Modified:
+                // a directory replaced within one batch, its contents may differ
+                if (QFileInfo(change.path).isDir()) {
+                    auto prefix = relPath + '/';
+                    files.erase(
+                        std::remove_if(files.begin(), files.end(), [&prefix](const QString& file) { return file.startsWith(prefix); }),
+                        files.end());
+                    removeFromWatcherRecursive(change.path);
+                    if (m_isEnabled)
+                        addFilesToWatcherRecursive(change.path);
+                    files.append(scanRecursive(change.path));
+                }
+                break;
+        }
+    }
+    setFiles(files);
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <QDir>
-#include <QFileSystemWatcher>
+#include "FileWatcher.h"
 #include "pathmatcher/IPathMatcher.h"
 
 class RecursiveFileSystemWatcher : public QObject {
@@ -34,15 +34,16 @@ class RecursiveFileSystemWatcher : public QObject {
     bool m_isEnabled = false;
     IPathMatcher::Ptr m_matcher;
 
-    QFileSystemWatcher* m_watcher;
+    FileWatcher* m_watcher;
 
     QStringList m_files;
     void setFiles(const QStringList& files);
 
     void addFilesToWatcherRecursive(const QDir& dir);
+    void removeFromWatcherRecursive(const QString& path);
     QStringList scanRecursive(const QDir& dir);
 
    private slots:
     void fileChange(const QString& path);
-    void directoryChange(const QString& path);
+    void directoryChange(const QString& path, const QList<FileWatcher::Change>& changes);
 };
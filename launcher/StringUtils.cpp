@@ -233,4 +233,14 @@ QString StringUtils::htmlListPatch(QString htmlStr)
         pos = htmlStr.indexOf(ulMatcher, pos);
     }
     return htmlStr;
-}
\ No newline at end of file
+}
+
+QString StringUtils::laxName(const QString& fileName, bool excludeDigits)
+{
+    auto name = fileName.toLower();
+    for (auto& c : name) {
+        if (c == '-' || c == '+' || c == '.' || c == '_' || (excludeDigits && c >= '0' && c <= '9'))
+            c = ' ';
+    }
+    return name.simplified();
+}
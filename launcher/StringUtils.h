@@ -87,4 +87,11 @@ QPair<QString, QString> splitFirst(const QString& s, const QRegularExpression& r
 
 QString htmlListPatch(QString htmlStr);
 
+/**
+ * @brief Normalizes a file name for a super lax (but not fuzzy) compare
+ * Lowercases it, turns all separators into whitespace and collapses that, so two names are lax equal when their laxName is equal.
+ * @param excludeDigits also treat digits as separators, so different versions of the same file compare equal
+ */
+QString laxName(const QString& fileName, bool excludeDigits = false);
+
 }  // namespace StringUtils
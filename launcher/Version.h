@@ -37,9 +37,9 @@
 #pragma once
 
 #include <QDebug>
-#include <QList>
 #include <QString>
 #include <QStringView>
+#include <QVector>
 
 class QUrl;
 
@@ -61,60 +61,58 @@ class Version {
     friend QDebug operator<<(QDebug debug, const Version& v);
 
    private:
+    // sections are parsed once so that comparing never has to copy or allocate
     struct Section {
-        explicit Section(QString fullString) : m_fullString(std::move(fullString))
+        explicit Section(const QString& version, int start, int length) : m_start(start), m_length(length)
         {
-            qsizetype cutoff = m_fullString.size();
-            for (int i = 0; i < m_fullString.size(); i++) {
-                if (!m_fullString[i].isDigit()) {
+            int cutoff = length;
+            for (int i = 0; i < length; i++) {
+                if (!version[start + i].isDigit()) {
                     cutoff = i;
                     break;
                 }
             }
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-            auto numPart = QStringView{ m_fullString }.left(cutoff);
+            auto fullString = QStringView{ version }.mid(start, length);
 #else
-            auto numPart = m_fullString.leftRef(cutoff);
+            auto fullString = version.midRef(start, length);
 #endif
 
+            auto numPart = fullString.left(cutoff);
             if (!numPart.isEmpty()) {
                 m_isNull = false;
                 m_numPart = numPart.toInt();
             }
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-            auto stringPart = QStringView{ m_fullString }.mid(cutoff);
-#else
-            auto stringPart = m_fullString.midRef(cutoff);
-#endif
-
+            auto stringPart = fullString.mid(cutoff);
             if (!stringPart.isEmpty()) {
                 m_isNull = false;
                 m_stringPart = stringPart.toString();
+                m_isAppendix = m_stringPart.startsWith('+');
+                m_isPreRelease = m_stringPart.startsWith('-') && m_stringPart.length() > 1;
             }
         }
 
         explicit Section() = default;
 
         bool m_isNull = true;
+        bool m_isAppendix = false;
+        bool m_isPreRelease = false;
 
         int m_numPart = 0;
         QString m_stringPart;
 
-        QString m_fullString;
-
-        [[nodiscard]] inline bool isAppendix() const { return m_stringPart.startsWith('+'); }
-        [[nodiscard]] inline bool isPreRelease() const { return m_stringPart.startsWith('-') && m_stringPart.length() > 1; }
+        // where this section is in the version string
+        int m_start = 0;
+        int m_length = 0;
 
         inline bool operator==(const Section& other) const
         {
-            if (m_isNull && !other.m_isNull)
-                return false;
-            if (!m_isNull && other.m_isNull)
+            if (m_isNull != other.m_isNull)
                 return false;
 
-            if (!m_isNull && !other.m_isNull) {
+            if (!m_isNull) {
                 return (m_numPart == other.m_numPart) && (m_stringPart == other.m_stringPart);
             }
 
@@ -126,7 +124,7 @@ class Version {
             static auto unequal_is_less = [](Section const& non_null) -> bool {
                 if (non_null.m_stringPart.isEmpty())
                     return non_null.m_numPart == 0;
-                return (non_null.m_stringPart != QLatin1Char('.')) && non_null.isPreRelease();
+                return (non_null.m_stringPart != QLatin1Char('.')) && non_null.m_isPreRelease;
             };
 
             if (!m_isNull && other.m_isNull)
@@ -148,7 +146,8 @@ class Version {
                 return false;
             }
 
-            return m_fullString < other.m_fullString;
+            // two null sections are equal
+            return false;
         }
 
         inline bool operator!=(const Section& other) const { return !(*this == other); }
@@ -157,7 +156,9 @@ class Version {
 
    private:
     QString m_string;
-    QList<Section> m_sections;
+    QVector<Section> m_sections;
 
+    /// negative, zero or positive like QString::compare
+    int compare(const Version& other) const;
     void parse();
 };
@@ -1,15 +1,16 @@
 
 #pragma once
 
-#include <QFileSystemWatcher>
 #include <QString>
 
+#include "FileWatcher.h"
+
 struct WatchLock {
-    WatchLock(QFileSystemWatcher* watcher, const QString& directory) : m_watcher(watcher), m_directory(directory)
+    WatchLock(FileWatcher* watcher, const QString& directory) : m_watcher(watcher), m_directory(directory)
     {
         m_watcher->removePath(m_directory);
     }
     ~WatchLock() { m_watcher->addPath(m_directory); }
-    QFileSystemWatcher* m_watcher;
+    FileWatcher* m_watcher;
     QString m_directory;
 };
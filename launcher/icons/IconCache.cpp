@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "IconCache.h"
+
+#include <QApplication>
+#include <QDebug>
+#include <QFutureWatcher>
+#include <QIconEngine>
+#include <QImageReader>
+#include <QPainter>
+#include <QPointer>
+#include <QStyle>
+#include <QStyleOption>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
+#include <optional>
+
+namespace {
+class CachedIconEngine : public QIconEngine {
+   public:
+    CachedIconEngine(IconCache* cache, const QString& path) : m_cache(cache), m_path(path) {}
+
+    void paint(QPainter* painter, const QRect& rect, QIcon::Mode mode, [[maybe_unused]] QIcon::State state) override
+    {
+        if (!m_cache)
+            return;
+        qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+        auto image = styled(m_cache->request(m_path, rect.size() * dpr), mode);
+        if (image.isNull())
+            return;
+        image.setDevicePixelRatio(dpr);
+        QRect target(QPoint(), image.size() / dpr);
+        target.moveCenter(rect.center());
+        painter->drawPixmap(target, image);
+    }
+
+    QPixmap pixmap(const QSize& size, QIcon::Mode mode, [[maybe_unused]] QIcon::State state) override
+    {
+        if (!m_cache)
+            return {};
+        return styled(m_cache->pixmap(m_path, size), mode);
+    }
+
+    QSize actualSize(const QSize& size, [[maybe_unused]] QIcon::Mode mode, [[maybe_unused]] QIcon::State state) override
+    {
+        auto original = originalSize();
+        if (!original.isValid() || (original.width() <= size.width() && original.height() <= size.height()))
+            return original;
+        return original.scaled(size, Qt::KeepAspectRatio);
+    }
+
+    QList<QSize> availableSizes([[maybe_unused]] QIcon::Mode mode, [[maybe_unused]] QIcon::State state) override
+    {
+        auto original = originalSize();
+        if (!original.isValid())
+            return {};
+        return { original };
+    }
+
+    QIconEngine* clone() const override
+    {
+        auto engine = new CachedIconEngine(m_cache, m_path);
+        engine->m_originalSize = m_originalSize;
+        return engine;
+    }
+
+    QString key() const override { return "CachedIconEngine"; }
+
+   private:
+    // QIcon::paint asks for this on every repaint, so the header is only read the first time
+    QSize originalSize()
+    {
+        if (!m_originalSize)
+            m_originalSize = QImageReader(m_path).size();
+        return *m_originalSize;
+    }
+
+    static QPixmap styled(const QPixmap& image, QIcon::Mode mode)
+    {
+        auto app = qobject_cast<QApplication*>(QCoreApplication::instance());
+        if (image.isNull() || mode == QIcon::Normal || !app)
+            return image;
+        QStyleOption option;
+        option.palette = app->palette();
+        return app->style()->generatedIconPixmap(mode, image, &option);
+    }
+
+   private:
+    QPointer<IconCache> m_cache;
+    QString m_path;
+    std::optional<QSize> m_originalSize;
+};
+}  // namespace
+
+IconCache::IconCache(int maxBytes, QObject* parent) : QObject(parent), m_pixmaps(maxBytes) {}
+
+QIcon IconCache::icon(const QString& path)
+{
+    return QIcon(new CachedIconEngine(this, path));
+}
+
+QString IconCache::cacheKey(const QString& path, const QSize& size)
+{
+    return QString("%1@%2x%3").arg(path).arg(size.width()).arg(size.height());
+}
+
+void IconCache::insert(const QString& key, const QImage& image)
+{
+    auto cost = static_cast<int>(image.sizeInBytes());
+    m_pixmaps.insert(key, new QPixmap(QPixmap::fromImage(image)), cost);
+}
+
+QPixmap IconCache::pixmap(const QString& path, const QSize& size)
+{
+    auto key = cacheKey(path, size);
+    if (auto cached = m_pixmaps.object(key))
+        return *cached;
+    if (m_failed.contains(key) || size.isEmpty())
+        return {};
+    auto image = load(path, size);
+    if (image.isNull()) {
+        m_failed.insert(key);
+        return {};
+    }
+    insert(key, image);
+    return QPixmap::fromImage(image);
+}
+
+QPixmap IconCache::request(const QString& path, const QSize& size)
+{
+    auto key = cacheKey(path, size);
+    if (auto cached = m_pixmaps.object(key))
+        return *cached;
+    if (m_pending.contains(key) || m_failed.contains(key) || size.isEmpty())
+        return {};
+
+    m_pending.insert(key);
+    auto watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, path] {
+        watcher->deleteLater();
+        // invalidated while decoding, the result may be stale
+        if (!m_pending.remove(key))
+            return;
+        auto image = watcher->result();
+        if (image.isNull()) {
+            qWarning() << "Failed to decode icon" << path;
+            m_failed.insert(key);
+            return;
+        }
+        insert(key, image);
+        emit loaded(path);
+    });
+    watcher->setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [path, size] { return IconCache::load(path, size); }));
+    return {};
+}
+
+void IconCache::invalidate(const QString& path)
+{
+    auto prefix = path + '@';
+    for (auto& key : m_pixmaps.keys()) {
+        if (key.startsWith(prefix))
+            m_pixmaps.remove(key);
+    }
+    for (auto& key : m_pending.values()) {
+        if (key.startsWith(prefix))
+            m_pending.remove(key);
+    }
+    for (auto& key : m_failed.values()) {
+        if (key.startsWith(prefix))
+            m_failed.remove(key);
+    }
+}
+
+QImage IconCache::load(const QString& path, const QSize& size)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+    auto original = reader.size();
+    auto target = original;
+    if (original.isValid() && (original.width() > size.width() || original.height() > size.height())) {
+        target = original.scaled(size, Qt::KeepAspectRatio);
+        // lets formats like JPEG decode at a fraction of their resolution
+        reader.setScaledSize(target);
+    }
+    auto image = reader.read();
+    if (!image.isNull() && target.isValid() && image.size() != target) {
+        image = image.scaled(target, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
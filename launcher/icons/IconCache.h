@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QCache>
+#include <QIcon>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+
+/** Decodes image files off the GUI thread, at the sizes they are drawn at.
+ *
+ *  Icons made by icon() ask the cache for a pixmap of the exact device size they are painted at. When painting, a miss
+ *  queues a decode on the thread pool and paints nothing; loaded() is emitted once the pixmap is ready, so views can
+ *  repaint. Asking the icon for a pixmap directly still decodes right away.
+ *  Decoded pixmaps are kept in a cache bounded by their size in bytes.
+ */
+class IconCache : public QObject {
+    Q_OBJECT
+   public:
+    explicit IconCache(int maxBytes, QObject* parent = nullptr);
+
+    /// A QIcon that draws the file through this cache
+    QIcon icon(const QString& path);
+
+    /// The image scaled to fit size if it is cached, otherwise queues the decode and returns a null pixmap
+    QPixmap request(const QString& path, const QSize& size);
+
+    /// The image scaled to fit size, decoded on the calling thread if it is not cached yet
+    QPixmap pixmap(const QString& path, const QSize& size);
+
+    /// Drops everything cached for the file, for when it changed on disk
+    void invalidate(const QString& path);
+
+    /// Decodes the file scaled down to fit size, on the calling thread. Images are never scaled up.
+    static QImage load(const QString& path, const QSize& size);
+
+   signals:
+    void loaded(const QString& path);
+
+   private:
+    static QString cacheKey(const QString& path, const QSize& size);
+    void insert(const QString& key, const QImage& image);
+
+   private:
+    QCache<QString, QPixmap> m_pixmaps;
+    QSet<QString> m_pending;
+    QSet<QString> m_failed;
+};
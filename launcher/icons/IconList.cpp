@@ -36,19 +36,26 @@
 
 #include "IconList.h"
 #include <FileSystem.h>
+#include <FileWatcher.h>
 #include <QDebug>
 #include <QEventLoop>
-#include <QFileSystemWatcher>
+#include <QImageReader>
 #include <QMap>
 #include <QMimeData>
 #include <QSet>
 #include <QUrl>
+#include "icons/IconCache.h"
 #include "icons/IconUtils.h"
 
 #define MAX_SIZE 1024
+// decoded pixmaps kept around, enough for a few thousand instance-sized icons
+#define CACHE_BYTES (64 * 1024 * 1024)
 
 IconList::IconList(const QStringList& builtinPaths, QString path, QObject* parent) : QAbstractListModel(parent)
 {
+    m_cache = new IconCache(CACHE_BYTES, this);
+    connect(m_cache, &IconCache::loaded, this, &IconList::iconLoaded);
+
     QSet<QString> builtinNames;
 
     // add builtin icons
@@ -63,10 +70,10 @@ IconList::IconList(const QStringList& builtinPaths, QString path, QObject* paren
         addThemeIcon(builtinName);
     }
 
-    m_watcher.reset(new QFileSystemWatcher());
+    m_watcher.reset(new FileWatcher());
     is_watching = false;
-    connect(m_watcher.get(), &QFileSystemWatcher::directoryChanged, this, &IconList::directoryChanged);
-    connect(m_watcher.get(), &QFileSystemWatcher::fileChanged, this, &IconList::fileChanged);
+    connect(m_watcher.get(), &FileWatcher::directoryChanged, this, &IconList::directoryChanged);
+    connect(m_watcher.get(), &FileWatcher::fileChanged, this, &IconList::fileChanged);
 
     directoryChanged(path);
 
@@ -179,15 +186,25 @@ void IconList::fileChanged(const QString& path)
     int idx = getIconIndex(key);
     if (idx == -1)
         return;
-    QIcon icon(path);
-    if (!icon.availableSizes().size())
+    if (!QImageReader(path).canRead())
         return;
 
-    icons[idx].m_images[IconType::FileBased].icon = icon;
+    m_cache->invalidate(path);
+    icons[idx].m_images[IconType::FileBased].icon = m_cache->icon(path);
     dataChanged(index(idx), index(idx));
     emit iconUpdated(key);
 }
 
+void IconList::iconLoaded(const QString& path)
+{
+    for (int i = 0; i < icons.size(); i++) {
+        if (icons[i].getFilePath() != path)
+            continue;
+        dataChanged(index(i), index(i), { Qt::DecorationRole });
+        emit iconUpdated(icons[i].m_key);
+    }
+}
+
 void IconList::SettingChanged(const Setting& setting, QVariant value)
 {
     if (setting.id() != "IconsDir")
@@ -356,9 +373,10 @@ bool IconList::addThemeIcon(const QString& key)
 bool IconList::addIcon(const QString& key, const QString& name, const QString& path, const IconType type)
 {
     // replace the icon even? is the input valid?
-    QIcon icon(path);
-    if (icon.isNull())
+    // only the header is checked here, the image itself is decoded when it is first painted
+    if (!QImageReader(path).canRead())
         return false;
+    auto icon = m_cache->icon(path);
     auto iter = name_index.find(key);
     if (iter != name_index.end()) {
         auto& oldOne = icons[*iter];
@@ -382,8 +400,13 @@ bool IconList::addIcon(const QString& key, const QString& name, const QString& p
 
 void IconList::saveIcon(const QString& key, const QString& path, const char* format) const
 {
-    auto icon = getIcon(key);
-    auto pixmap = icon.pixmap(128, 128);
+    // the cache decodes asynchronously, so file based icons are decoded here instead
+    auto entry = icon(key);
+    if (entry && !entry->getFilePath().isEmpty()) {
+        IconCache::load(entry->getFilePath(), QSize(128, 128)).save(path, format);
+        return;
+    }
+    auto pixmap = getIcon(key).pixmap(128, 128);
     pixmap.save(path, format);
 }
 
@@ -46,7 +46,8 @@
 
 #include "QObjectPtr.h"
 
-class QFileSystemWatcher;
+class FileWatcher;
+class IconCache;
 
 class IconList : public QAbstractListModel {
     Q_OBJECT
@@ -98,9 +99,11 @@ class IconList : public QAbstractListModel {
    protected slots:
     void fileChanged(const QString& path);
     void SettingChanged(const Setting& setting, QVariant value);
+    void iconLoaded(const QString& path);
 
    private:
-    shared_qobject_ptr<QFileSystemWatcher> m_watcher;
+    shared_qobject_ptr<FileWatcher> m_watcher;
+    IconCache* m_cache;
     bool is_watching;
     QMap<QString, int> name_index;
     QVector<MMCIcon> icons;
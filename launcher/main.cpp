@@ -63,6 +63,13 @@ int main(int argc, char* argv[])
     QGuiApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
 #endif
 
+    // --batch runs on machines without a display and never shows a window
+    for (int i = 1; i < argc; i++) {
+        auto arg = QByteArray(argv[i]);
+        if ((arg == "--batch" || arg.startsWith("--batch=")) && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     // initialize Qt
     Application app(argc, argv);
 
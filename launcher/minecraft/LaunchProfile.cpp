@@ -154,7 +154,7 @@ void LaunchProfile::applyMods(const QList<LibraryPtr>& mods)
 
         auto existingLibrary = list->at(index);
         // if we are higher it means we should update
-        if (Version(mod->version()) > Version(existingLibrary->version())) {
+        if (mod->comparableVersion() > existingLibrary->comparableVersion()) {
             list->replace(index, modCopy);
         }
     }
@@ -194,7 +194,7 @@ void LaunchProfile::applyLibrary(LibraryPtr library, const RuntimeContext& runti
 
     auto existingLibrary = list->at(index);
     // if we are higher it means we should update
-    if (Version(library->version()) > Version(existingLibrary->version())) {
+    if (library->comparableVersion() > existingLibrary->comparableVersion()) {
         list->replace(index, libraryCopy);
     }
 }
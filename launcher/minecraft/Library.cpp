@@ -378,6 +378,15 @@ QString Library::displayName(const RuntimeContext& runtimeContext) const
     return filename(runtimeContext);
 }
 
+const Version& Library::comparableVersion() const
+{
+    // m_name can be replaced wholesale by the format parsers, so check rather than invalidate
+    auto version = m_name.version();
+    if (m_comparableVersion.toString() != version)
+        m_comparableVersion = Version(version);
+    return m_comparableVersion;
+}
+
 /**
  * @brief Get the storage suffix for the library in the current runtime context.
  *
@@ -47,6 +47,7 @@
 #include "MojangDownloadInfo.h"
 #include "Rule.h"
 #include "RuntimeContext.h"
+#include "Version.h"
 #include "net/NetRequest.h"
 
 class Library;
@@ -96,6 +97,9 @@ class Library {
     /// get the artifact version
     QString version() const { return m_name.version(); }
 
+    /// get the artifact version, parsed once for comparisons
+    const Version& comparableVersion() const;
+
     /// Returns true if the library is native
     bool isNative() const { return m_nativeClassifiers.size() != 0; }
 
@@ -167,6 +171,9 @@ class Library {
     /// the basic gradle dependency specifier.
     GradleSpecifier m_name;
 
+    /// cached parse of m_name's version
+    mutable Version m_comparableVersion;
+
     /// DEPRECATED URL prefix of the maven repo where the file can be downloaded
     QString m_repositoryURL;
 
@@ -52,8 +52,7 @@
 #include "FileSystem.h"
 #include "MMCTime.h"
 #include "java/JavaVersion.h"
-#include "pathmatcher/MultiMatcher.h"
-#include "pathmatcher/RegexpMatcher.h"
+#include "pathmatcher/CompiledMatcher.h"
 
 #include "launch/LaunchTask.h"
 #include "launch/TaskStepWrapper.h"
@@ -980,11 +979,11 @@ MessageLevel::Enum MinecraftInstance::guessLevel(const QString& line, MessageLev
 
 IPathMatcher::Ptr MinecraftInstance::getLogFileMatcher()
 {
-    auto combined = std::make_shared<MultiMatcher>();
-    combined->add(std::make_shared<RegexpMatcher>(".*\\.log(\\.[0-9]*)?(\\.gz)?$"));
-    combined->add(std::make_shared<RegexpMatcher>("crash-.*\\.txt"));
-    combined->add(std::make_shared<RegexpMatcher>("IDMap dump.*\\.txt$"));
-    combined->add(std::make_shared<RegexpMatcher>("ModLoader\\.txt(\\..*)?$"));
+    auto combined = std::make_shared<CompiledMatcher>();
+    combined->addRegexp(".*\\.log(\\.[0-9]*)?(\\.gz)?$");
+    combined->addRegexp("crash-.*\\.txt");
+    combined->addRegexp("IDMap dump.*\\.txt$");
+    combined->addRegexp("ModLoader\\.txt(\\..*)?$");
     return combined;
 }
 
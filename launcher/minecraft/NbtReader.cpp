@@ -0,0 +1,363 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "NbtReader.h"
+
+#include <QIODevice>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QtEndian>
+
+#include "GZip.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+enum TagType : quint8 {
+    TagEnd = 0,
+    TagByte,
+    TagShort,
+    TagInt,
+    TagLong,
+    TagFloat,
+    TagDouble,
+    TagByteArray,
+    TagString,
+    TagList,
+    TagCompound,
+    TagIntArray,
+    TagLongArray,
+};
+
+// deeper than anything the game writes, but keeps a malicious file from blowing the stack
+const int MAX_DEPTH = 512;
+// same for the payloads we allocate, a corrupt length must not turn into a huge allocation
+const qint64 MAX_PAYLOAD_BYTES = 64 * 1024 * 1024;
+
+struct ParseError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+qint64 fixedSize(quint8 type)
+{
+    switch (type) {
+        case TagByte:
+            return 1;
+        case TagShort:
+            return 2;
+        case TagInt:
+        case TagFloat:
+            return 4;
+        case TagLong:
+        case TagDouble:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// the fewest bytes a payload of the type can take up
+qint64 minimumSize(quint8 type)
+{
+    switch (type) {
+        case TagCompound:
+            return 1;
+        case TagString:
+            return 2;
+        case TagByteArray:
+        case TagIntArray:
+        case TagLongArray:
+            return 4;
+        case TagList:
+            return 5;
+        default:
+            return fixedSize(type);
+    }
+}
+}  // namespace
+
+class NbtReader::Source {
+   public:
+    virtual ~Source() = default;
+
+    /// Reads at most len bytes, returns how many were read, 0 at the end of the data and -1 on error
+    virtual qint64 readSome(char* data, qint64 len) = 0;
+    /// Bytes left to read, or -1 when that isn't known up front, as with compressed data
+    virtual qint64 remaining() const { return -1; }
+
+    /// Checks that count elements of elementSize bytes can be there before anything is allocated for them
+    void checkPayload(qint64 count, qint64 elementSize) const
+    {
+        auto bytes = count * elementSize;
+        if (bytes > MAX_PAYLOAD_BYTES)
+            throw ParseError("NBT payload is too large");
+        auto left = remaining();
+        if (left >= 0 && bytes > left)
+            throw ParseError("NBT payload is longer than the data");
+    }
+
+    void read(char* data, qint64 len)
+    {
+        while (len > 0) {
+            auto count = readSome(data, len);
+            if (count <= 0)
+                throw ParseError("unexpected end of NBT data");
+            data += count;
+            len -= count;
+        }
+    }
+
+    void skip(qint64 len)
+    {
+        char buffer[4096];
+        while (len > 0) {
+            auto count = readSome(buffer, qMin<qint64>(len, sizeof(buffer)));
+            if (count <= 0)
+                throw ParseError("unexpected end of NBT data");
+            len -= count;
+        }
+    }
+
+    template <typename T>
+    T readNumber()
+    {
+        uchar bytes[sizeof(T)];
+        read(reinterpret_cast<char*>(bytes), sizeof(T));
+        return qFromBigEndian<T>(bytes);
+    }
+
+    qint64 readLength()
+    {
+        auto length = readNumber<qint32>();
+        if (length < 0)
+            throw ParseError("negative length in NBT data");
+        return length;
+    }
+
+    QString readString()
+    {
+        auto length = readNumber<quint16>();
+        QByteArray bytes(static_cast<int>(length), Qt::Uninitialized);
+        read(bytes.data(), length);
+        return QString::fromUtf8(bytes);
+    }
+};
+
+class NbtReader::DeviceSource : public NbtReader::Source {
+   public:
+    explicit DeviceSource(QIODevice* device) : m_device(device) {}
+
+    qint64 readSome(char* data, qint64 len) override { return m_device->read(data, len); }
+    qint64 remaining() const override { return m_device->isSequential() ? -1 : m_device->size() - m_device->pos(); }
+
+   private:
+    QIODevice* m_device;
+};
+
+NbtReader::NbtReader(const QStringList& paths)
+{
+    for (auto& path : paths) {
+        m_paths.insert(path);
+        auto parts = path.split('.');
+        for (int i = 1; i < parts.size(); i++) {
+            m_prefixes.insert(parts.mid(0, i).join('.'));
+        }
+    }
+}
+
+bool NbtReader::read(QIODevice* device)
+{
+    DeviceSource source(device);
+    return readRoot(source);
+}
+
+bool NbtReader::readCompressed(QIODevice* device)
+{
+    GZipDevice gzip(device);
+    if (!gzip.open(QIODevice::ReadOnly)) {
+        m_error = gzip.errorString();
+        return false;
+    }
+    DeviceSource source(&gzip);
+    return readRoot(source);
+}
+
+bool NbtReader::readRoot(Source& source)
+{
+    m_values.clear();
+    m_compounds.clear();
+    m_rootName.clear();
+    m_error.clear();
+    try {
+        if (source.readNumber<quint8>() != TagCompound)
+            throw ParseError("root tag is not a compound");
+        m_rootName = source.readString();
+        readCompound(source, QString(), 0);
+        return true;
+    } catch (const ParseError& e) {
+        m_error = QString::fromUtf8(e.what());
+        return false;
+    }
+}
+
+void NbtReader::readCompound(Source& source, const QString& prefix, int depth)
+{
+    if (depth > MAX_DEPTH)
+        throw ParseError("NBT data is nested too deeply");
+    m_compounds.insert(prefix);
+    for (;;) {
+        auto type = source.readNumber<quint8>();
+        if (type == TagEnd)
+            return;
+        auto name = source.readString();
+        auto path = prefix.isEmpty() ? name : prefix + '.' + name;
+        if (m_paths.contains(path)) {
+            m_values.insert(path, readPayload(source, type, depth + 1));
+        } else if (type == TagCompound && m_prefixes.contains(path)) {
+            readCompound(source, path, depth + 1);
+        } else {
+            skipPayload(source, type, depth + 1);
+        }
+    }
+}
+
+QVariant NbtReader::readPayload(Source& source, quint8 type, int depth)
+{
+    if (depth > MAX_DEPTH)
+        throw ParseError("NBT data is nested too deeply");
+    switch (type) {
+        case TagByte:
+            return QVariant::fromValue(source.readNumber<qint8>());
+        case TagShort:
+            return QVariant::fromValue(source.readNumber<qint16>());
+        case TagInt:
+            return source.readNumber<qint32>();
+        case TagLong:
+            return static_cast<qlonglong>(source.readNumber<qint64>());
+        case TagFloat: {
+            auto bits = source.readNumber<quint32>();
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        case TagDouble: {
+            auto bits = source.readNumber<quint64>();
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        case TagByteArray: {
+            auto length = source.readLength();
+            source.checkPayload(length, 1);
+            QByteArray bytes(static_cast<int>(length), Qt::Uninitialized);
+            source.read(bytes.data(), length);
+            return bytes;
+        }
+        case TagString:
+            return source.readString();
+        case TagList: {
+            auto elementType = source.readNumber<quint8>();
+            auto length = source.readLength();
+            source.checkPayload(length, qMax<qint64>(minimumSize(elementType), 1));
+            QVariantList list;
+            for (qint64 i = 0; i < length; i++) {
+                list.append(readPayload(source, elementType, depth + 1));
+            }
+            return list;
+        }
+        case TagCompound: {
+            QVariantMap map;
+            for (;;) {
+                auto childType = source.readNumber<quint8>();
+                if (childType == TagEnd)
+                    break;
+                auto name = source.readString();
+                map.insert(name, readPayload(source, childType, depth + 1));
+            }
+            return map;
+        }
+        case TagIntArray: {
+            auto length = source.readLength();
+            source.checkPayload(length, 4);
+            QVariantList list;
+            for (qint64 i = 0; i < length; i++) {
+                list.append(source.readNumber<qint32>());
+            }
+            return list;
+        }
+        case TagLongArray: {
+            auto length = source.readLength();
+            source.checkPayload(length, 8);
+            QVariantList list;
+            for (qint64 i = 0; i < length; i++) {
+                list.append(static_cast<qlonglong>(source.readNumber<qint64>()));
+            }
+            return list;
+        }
+        default:
+            throw ParseError("unknown NBT tag type " + std::to_string(type));
+    }
+}
+
+void NbtReader::skipPayload(Source& source, quint8 type, int depth)
+{
+    if (depth > MAX_DEPTH)
+        throw ParseError("NBT data is nested too deeply");
+    if (auto size = fixedSize(type)) {
+        source.skip(size);
+        return;
+    }
+    switch (type) {
+        case TagByteArray:
+            source.skip(source.readLength());
+            break;
+        case TagString:
+            source.skip(source.readNumber<quint16>());
+            break;
+        case TagList: {
+            auto elementType = source.readNumber<quint8>();
+            auto length = source.readLength();
+            if (auto size = fixedSize(elementType)) {
+                source.skip(length * size);
+            } else {
+                for (qint64 i = 0; i < length; i++) {
+                    skipPayload(source, elementType, depth + 1);
+                }
+            }
+            break;
+        }
+        case TagCompound:
+            for (;;) {
+                auto childType = source.readNumber<quint8>();
+                if (childType == TagEnd)
+                    break;
+                source.skip(source.readNumber<quint16>());
+                skipPayload(source, childType, depth + 1);
+            }
+            break;
+        case TagIntArray:
+            source.skip(source.readLength() * 4);
+            break;
+        case TagLongArray:
+            source.skip(source.readLength() * 8);
+            break;
+        default:
+            throw ParseError("unknown NBT tag type " + std::to_string(type));
+    }
+}
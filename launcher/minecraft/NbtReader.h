@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+class QIODevice;
+
+/** Reads selected values out of an NBT stream without building the whole tree.
+ *
+ *  Paths name tags by their compound keys joined with '.', starting below the root compound,
+ *  e.g. "Data.LevelName". Everything that is not on the way to a requested path is skipped
+ *  in place. Requested tags are converted to QVariant: numbers keep their NBT width (qint8,
+ *  qint16, int, qlonglong, float, double), strings become QString, byte arrays QByteArray,
+ *  lists and int/long arrays QVariantList and compounds QVariantMap.
+ */
+class NbtReader {
+   public:
+    explicit NbtReader(const QStringList& paths);
+
+    /// Reads an uncompressed NBT stream, like servers.dat
+    bool read(QIODevice* device);
+    /// Reads a gzip compressed NBT stream, like level.dat, inflating it as it goes
+    bool readCompressed(QIODevice* device);
+
+    bool contains(const QString& path) const { return m_values.contains(path); }
+    QVariant value(const QString& path) const { return m_values.value(path); }
+    /// True if the tag at the path was a compound on the way to a requested path
+    bool isCompound(const QString& path) const { return m_compounds.contains(path); }
+
+    QString rootName() const { return m_rootName; }
+    QString errorString() const { return m_error; }
+
+   private:
+    class Source;
+    class DeviceSource;
+
+    bool readRoot(Source& source);
+    void readCompound(Source& source, const QString& prefix, int depth);
+    QVariant readPayload(Source& source, quint8 type, int depth);
+    void skipPayload(Source& source, quint8 type, int depth);
+
+   private:
+    QSet<QString> m_paths;
+    QSet<QString> m_prefixes;
+    QHash<QString, QVariant> m_values;
+    QSet<QString> m_compounds;
+    QString m_rootName;
+    QString m_error;
+};
@@ -35,6 +35,7 @@
  */
 
 #include "World.h"
+#include <QBuffer>
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
@@ -50,6 +51,7 @@
 #include <tag_string.h>
 #include <sstream>
 #include "GZip.h"
+#include "NbtReader.h"
 
 #include <QCoreApplication>
 
@@ -187,18 +189,15 @@ bool putLevelDatDataToFS(const QFileInfo& file, QByteArray& data)
     if (!f.open(QIODevice::WriteOnly)) {
         return false;
     }
-    QByteArray compressed;
-    if (!GZip::zip(data, compressed)) {
-        return false;
-    }
-    if (f.write(compressed) != compressed.size()) {
+    GZipDevice gzip(&f);
+    if (!gzip.open(QIODevice::WriteOnly) || gzip.write(data) != data.size() || !gzip.finish()) {
         f.cancelWriting();
         return false;
     }
     return f.commit();
 }
 
-int64_t calculateWorldSize(const QFileInfo& file)
+int64_t World::calculateSize(const QFileInfo& file)
 {
     if (file.isFile() && file.suffix() == "zip") {
         return file.size();
@@ -214,16 +213,25 @@ int64_t calculateWorldSize(const QFileInfo& file)
     return -1;
 }
 
-World::World(const QFileInfo& file)
+World::World(const QFileInfo& file, bool calculateSize)
+{
+    repath(file, calculateSize);
+}
+
+World World::placeholder(const QFileInfo& file)
 {
-    repath(file);
+    World world;
+    world.m_containerFile = file;
+    world.m_folderName = file.fileName();
+    world.m_actualName = world.m_folderName;
+    return world;
 }
 
-void World::repath(const QFileInfo& file)
+void World::repath(const QFileInfo& file, bool calculateSize)
 {
     m_containerFile = file;
     m_folderName = file.fileName();
-    m_size = calculateWorldSize(file);
+    m_size = calculateSize ? World::calculateSize(file) : -1;
     if (file.isFile() && file.suffix() == "zip") {
         m_iconFile = QString();
         readFromZip(file);
@@ -359,111 +367,56 @@ bool World::rename(const QString& newName)
 
 namespace {
 
-optional<QString> read_string(nbt::value& parent, const char* name)
+template <typename T>
+optional<T> read_value(const NbtReader& reader, const QString& path)
 {
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::String) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_string>();
-        return QString::fromStdString(tag_str.get());
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
+    auto value = reader.value(path);
+    if (!value.isValid()) {
         // fallback for old world formats
-        qWarning() << "String NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to string.";
+        qWarning() << "NBT tag" << path << "could not be found.";
         return nullopt;
     }
-}
-
-optional<int64_t> read_long(nbt::value& parent, const char* name)
-{
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::Long) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_long>();
-        return tag_str.get();
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "Long NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
+    if (value.userType() != qMetaTypeId<T>()) {
         // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to long.";
+        qWarning() << "NBT tag" << path << "has an unexpected type.";
         return nullopt;
     }
-}
-
-optional<int> read_int(nbt::value& parent, const char* name)
-{
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::Int) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_int>();
-        return tag_str.get();
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "Int NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to int.";
-        return nullopt;
-    }
-}
-
-GameType read_gametype(nbt::value& parent, const char* name)
-{
-    return GameType(read_int(parent, name));
+    return value.value<T>();
 }
 
 }  // namespace
 
 void World::loadFromLevelDat(QByteArray data)
 {
-    auto levelData = parseLevelDat(data);
-    if (!levelData) {
+    NbtReader reader({ "Data.LevelName", "Data.LastPlayed", "Data.GameType", "Data.WorldGenSettings.seed", "Data.RandomSeed" });
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    if (!reader.readCompressed(&buffer) || !reader.rootName().isEmpty()) {
+        qWarning() << "Unable to parse level.dat of" << m_folderName << ":" << reader.errorString();
         is_valid = false;
         return;
     }
 
-    nbt::value* valPtr = nullptr;
-    try {
-        valPtr = &levelData->at("Data");
-    } catch (const std::out_of_range& e) {
-        qWarning() << "Unable to read NBT tags from " << m_folderName << ":" << e.what();
-        is_valid = false;
+    is_valid = reader.isCompound("Data");
+    if (!is_valid) {
+        qWarning() << "Unable to read NBT tags from " << m_folderName << ": no Data compound";
         return;
     }
-    nbt::value& val = *valPtr;
 
-    is_valid = val.get_type() == nbt::tag_type::Compound;
-    if (!is_valid)
-        return;
-
-    auto name = read_string(val, "LevelName");
+    auto name = read_value<QString>(reader, "Data.LevelName");
     m_actualName = name ? *name : m_folderName;
 
-    auto timestamp = read_long(val, "LastPlayed");
+    auto timestamp = read_value<qlonglong>(reader, "Data.LastPlayed");
     m_lastPlayed = timestamp ? QDateTime::fromMSecsSinceEpoch(*timestamp) : levelDatTime;
 
-    m_gameType = read_gametype(val, "GameType");
+    m_gameType = GameType(read_value<int>(reader, "Data.GameType"));
 
-    optional<int64_t> randomSeed;
-    try {
-        auto& WorldGen_val = val.at("WorldGenSettings");
-        randomSeed = read_long(WorldGen_val, "seed");
-    } catch (const std::out_of_range&) {
+    optional<qlonglong> randomSeed;
+    if (reader.isCompound("Data.WorldGenSettings")) {
+        randomSeed = read_value<qlonglong>(reader, "Data.WorldGenSettings.seed");
     }
     if (!randomSeed) {
-        randomSeed = read_long(val, "RandomSeed");
+        randomSeed = read_value<qlonglong>(reader, "Data.RandomSeed");
     }
     m_randomSeed = randomSeed ? *randomSeed : 0;
 
@@ -472,7 +425,9 @@ void World::loadFromLevelDat(QByteArray data)
     if (randomSeed) {
         qDebug() << "Seed:" << *randomSeed;
     }
-    qDebug() << "Size:" << m_size;
+    if (m_size >= 0) {
+        qDebug() << "Size:" << m_size;
+    }
     qDebug() << "GameType:" << m_gameType.toLogString();
 }
 
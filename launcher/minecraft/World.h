@@ -31,7 +31,10 @@ struct GameType {
 
 class World {
    public:
-    World(const QFileInfo& file);
+    World() = default;
+    World(const QFileInfo& file, bool calculateSize = true);
+    // an unloaded entry for the folder, showing only its folder name
+    static World placeholder(const QFileInfo& file);
     QString folderName() const { return m_folderName; }
     QString name() const { return m_actualName; }
     QString iconFile() const { return m_iconFile; }
@@ -47,7 +50,10 @@ class World {
     // replace this world with a copy of the other
     bool replace(World& with);
     // change the world's filesystem path (used by world lists for *MAGIC* purposes)
-    void repath(const QFileInfo& file);
+    void repath(const QFileInfo& file, bool calculateSize = true);
+    // size of the world on disk, -1 if it has not been calculated
+    void setBytes(int64_t bytes) { m_size = bytes; }
+    static int64_t calculateSize(const QFileInfo& file);
     // remove the icon file, if any
     bool resetIcon();
 
@@ -85,7 +91,7 @@ class World {
     QString m_iconFile;
     QDateTime levelDatTime;
     QDateTime m_lastPlayed;
-    int64_t m_size;
+    int64_t m_size = -1;
     int64_t m_randomSeed = 0;
     GameType m_gameType;
     bool is_valid = false;
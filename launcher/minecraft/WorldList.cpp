@@ -36,13 +36,14 @@
 #include "WorldList.h"
 
 #include <FileSystem.h>
+#include <FileWatcher.h>
 #include <QDebug>
-#include <QFileSystemWatcher>
 #include <QMimeData>
 #include <QString>
 #include <QUrl>
 #include <QUuid>
 #include <Qt>
+#include <QtConcurrent>
 #include "Application.h"
 
 WorldList::WorldList(const QString& dir, BaseInstance* instance) : QAbstractListModel(), m_instance(instance), m_dir(dir)
@@ -50,9 +51,12 @@ WorldList::WorldList(const QString& dir, BaseInstance* instance) : QAbstractList
     FS::ensureFolderPathExists(m_dir.absolutePath());
     m_dir.setFilter(QDir::Readable | QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
     m_dir.setSorting(QDir::Name | QDir::IgnoreCase | QDir::LocaleAware);
-    m_watcher = new QFileSystemWatcher(this);
+    m_watcher = new FileWatcher(this);
     is_watching = false;
-    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &WorldList::directoryChanged);
+    connect(m_watcher, &FileWatcher::directoryChanged, this, &WorldList::directoryChanged);
+    connect(&m_scanWatcher, &QFutureWatcher<World>::resultReadyAt, this, &WorldList::worldScanned);
+    connect(&m_scanWatcher, &QFutureWatcher<World>::finished, this, &WorldList::worldScanFinished);
+    connect(&m_sizeWatcher, &QFutureWatcher<WorldSize>::resultReadyAt, this, &WorldList::sizeCalculated);
 }
 
 void WorldList::startWatching()
@@ -87,7 +91,11 @@ bool WorldList::update()
     if (!isValid())
         return false;
 
+    m_scanWatcher.cancel();
+    m_sizeWatcher.cancel();
+
     QList<World> newWorlds;
+    QStringList toScan;
     m_dir.refresh();
     auto folderContents = m_dir.entryInfoList();
     // if there are any untracked files...
@@ -95,17 +103,83 @@ bool WorldList::update()
         if (!entry.isDir())
             continue;
 
-        World w(entry);
-        if (w.isValid()) {
-            newWorlds.append(w);
-        }
+        auto path = entry.absoluteFilePath();
+        if (!QFileInfo::exists(FS::PathCombine(path, "level.dat")))
+            continue;
+
+        // keep showing what we already know about the world until the scan replaces it
+        auto row = rowOf(path);
+        World w = row >= 0 ? worlds[row] : World::placeholder(entry);
+        auto cached = m_sizeCache.constFind(path);
+        w.setBytes(cached != m_sizeCache.constEnd() && cached->modified == entry.lastModified() ? cached->bytes : -1);
+        newWorlds.append(w);
+        toScan.append(path);
     }
     beginResetModel();
     worlds.swap(newWorlds);
     endResetModel();
+
+    std::function<World(const QString&)> scan = [](const QString& path) { return World(QFileInfo(path), false); };
+    m_scanWatcher.setFuture(QtConcurrent::mapped(toScan, scan));
     return true;
 }
 
+int WorldList::rowOf(const QString& path) const
+{
+    for (int i = 0; i < worlds.size(); i++) {
+        if (worlds[i].container().absoluteFilePath() == path)
+            return i;
+    }
+    return -1;
+}
+
+void WorldList::worldScanned(int resultIndex)
+{
+    auto world = m_scanWatcher.resultAt(resultIndex);
+    auto row = rowOf(world.container().absoluteFilePath());
+    if (row < 0)
+        return;
+    world.setBytes(worlds[row].bytes());
+    worlds[row] = world;
+    emit dataChanged(index(row, 0), index(row, columnCount(QModelIndex()) - 1));
+}
+
+void WorldList::worldScanFinished()
+{
+    if (m_scanWatcher.isCanceled())
+        return;
+
+    // every folder has been looked at now, drop the ones that turned out not to be worlds
+    QStringList toMeasure;
+    for (int row = worlds.size() - 1; row >= 0; row--) {
+        if (!worlds[row].isValid()) {
+            beginRemoveRows(QModelIndex(), row, row);
+            worlds.removeAt(row);
+            endRemoveRows();
+        } else if (worlds[row].bytes() < 0) {
+            toMeasure.prepend(worlds[row].container().absoluteFilePath());
+        }
+    }
+    emit scanFinished();
+
+    std::function<WorldSize(const QString&)> measure = [](const QString& path) {
+        QFileInfo info(path);
+        return WorldSize{ path, info.lastModified(), World::calculateSize(info) };
+    };
+    m_sizeWatcher.setFuture(QtConcurrent::mapped(toMeasure, measure));
+}
+
+void WorldList::sizeCalculated(int resultIndex)
+{
+    auto size = m_sizeWatcher.resultAt(resultIndex);
+    m_sizeCache.insert(size.path, size);
+    auto row = rowOf(size.path);
+    if (row < 0)
+        return;
+    worlds[row].setBytes(size.bytes);
+    emit dataChanged(index(row, SizeColumn), index(row, SizeColumn));
+}
+
 void WorldList::directoryChanged(QString path)
 {
     update();
@@ -193,6 +267,9 @@ QVariant WorldList::data(const QModelIndex& index, int role) const
                     return world.lastPlayed();
 
                 case SizeColumn:
+                    if (world.bytes() < 0) {
+                        return tr("Calculating...");
+                    }
                     return locale.formattedDataSize(world.bytes());
 
                 case InfoColumn:
@@ -16,14 +16,17 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QDateTime>
 #include <QDir>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QList>
 #include <QMimeData>
 #include <QString>
 #include "BaseInstance.h"
 #include "minecraft/World.h"
 
-class QFileSystemWatcher;
+class FileWatcher;
 
 class WorldList : public QAbstractListModel {
     Q_OBJECT
@@ -44,7 +47,8 @@ class WorldList : public QAbstractListModel {
     bool empty() const { return size() == 0; }
     World& operator[](size_t index) { return worlds[index]; }
 
-    /// Reloads the mod list and returns true if the list changed.
+    /// Reloads the world list and returns true if the list changed.
+    /// Rows show up right away, names and sizes are filled in from a background scan.
     virtual bool update();
 
     /// Install a world from location
@@ -86,14 +90,32 @@ class WorldList : public QAbstractListModel {
 
    private slots:
     void directoryChanged(QString path);
+    void worldScanned(int index);
+    void worldScanFinished();
+    void sizeCalculated(int index);
+
+   private:
+    struct WorldSize {
+        QString path;
+        QDateTime modified;
+        int64_t bytes = -1;
+    };
+
+    int rowOf(const QString& path) const;
 
    signals:
     void changed();
+    void scanFinished();
 
    protected:
     BaseInstance* m_instance;
-    QFileSystemWatcher* m_watcher;
+    FileWatcher* m_watcher;
     bool is_watching;
     QDir m_dir;
     QList<World> worlds;
+
+    QFutureWatcher<World> m_scanWatcher;
+    QFutureWatcher<WorldSize> m_sizeWatcher;
+    // absolute path -> size, valid as long as the world folder mtime matches
+    QHash<QString, WorldSize> m_sizeCache;
 };
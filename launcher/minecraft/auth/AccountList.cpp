@@ -54,14 +54,13 @@
 
 enum AccountListVersion { MojangMSA = 3 };
 
+const int MAX_CONCURRENT_REFRESHES = 3;
+
 AccountList::AccountList(QObject* parent) : QAbstractListModel(parent)
 {
     m_refreshTimer = new QTimer(this);
     m_refreshTimer->setSingleShot(true);
     connect(m_refreshTimer, &QTimer::timeout, this, &AccountList::fillQueue);
-    m_nextTimer = new QTimer(this);
-    m_nextTimer->setSingleShot(true);
-    connect(m_nextTimer, &QTimer::timeout, this, &AccountList::tryNext);
 }
 
 AccountList::~AccountList() noexcept {}
@@ -615,9 +614,7 @@ void AccountList::requestRefresh(QString accountId)
     }
     m_refreshQueue.push_front(accountId);
     qDebug() << "AccountList: Pushed account with internal ID " << accountId << " to the front of the queue";
-    if (!isActive()) {
-        tryNext();
-    }
+    tryNext();
 }
 
 void AccountList::queueRefresh(QString accountId)
@@ -631,41 +628,55 @@ void AccountList::queueRefresh(QString accountId)
 
 void AccountList::tryNext()
 {
-    while (m_refreshQueue.length()) {
+    // accounts are independent, so a few of them can refresh at once. The cap keeps us clear of rate limits.
+    while (m_refreshQueue.length() && m_currentTasks.size() < MAX_CONCURRENT_REFRESHES) {
         auto accountId = m_refreshQueue.front();
         m_refreshQueue.pop_front();
+        if (m_currentTasks.contains(accountId)) {
+            continue;
+        }
+        MinecraftAccountPtr account;
         for (int i = 0; i < count(); i++) {
-            auto account = at(i);
-            if (account->internalId() == accountId) {
-                m_currentTask = account->refresh();
-                if (m_currentTask) {
-                    connect(m_currentTask.get(), &Task::succeeded, this, &AccountList::authSucceeded);
-                    connect(m_currentTask.get(), &Task::failed, this, &AccountList::authFailed);
-                    m_currentTask->start();
-                    qDebug() << "RefreshSchedule: Processing account " << account->accountDisplayString() << " with internal ID "
-                             << accountId;
-                    return;
-                }
+            if (at(i)->internalId() == accountId) {
+                account = at(i);
+                break;
             }
         }
-        qDebug() << "RefreshSchedule: Account with with internal ID " << accountId << " not found.";
+        if (!account) {
+            qDebug() << "RefreshSchedule: Account with with internal ID " << accountId << " not found.";
+            continue;
+        }
+        auto task = account->refresh();
+        if (!task) {
+            continue;
+        }
+        m_currentTasks.insert(accountId, task);
+        connect(task.get(), &Task::succeeded, this, &AccountList::authSucceeded);
+        connect(task.get(), &Task::failed, this, &AccountList::authFailed);
+        connect(task.get(), &Task::finished, this, [this, accountId] {
+            m_currentTasks.remove(accountId);
+            tryNext();
+        });
+        qDebug() << "RefreshSchedule: Processing account " << account->accountDisplayString() << " with internal ID " << accountId;
+        // the launch may have started this refresh already
+        if (!task->isRunning()) {
+            task->start();
+        }
+    }
+    if (m_refreshQueue.isEmpty() && m_currentTasks.isEmpty()) {
+        // if we get here, no account needs refreshing. Schedule refresh in an hour.
+        m_refreshTimer->start(1000 * 3600);
     }
-    // if we get here, no account needed refreshing. Schedule refresh in an hour.
-    m_refreshTimer->start(1000 * 3600);
 }
 
 void AccountList::authSucceeded()
 {
     qDebug() << "RefreshSchedule: Background account refresh succeeded";
-    m_currentTask.reset();
-    m_nextTimer->start(1000 * 20);
 }
 
 void AccountList::authFailed(QString reason)
 {
     qDebug() << "RefreshSchedule: Background account refresh failed: " << reason;
-    m_currentTask.reset();
-    m_nextTimer->start(1000 * 20);
 }
 
 bool AccountList::isActive() const
@@ -39,6 +39,7 @@
 #include "minecraft/auth/AuthFlow.h"
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QObject>
 #include <QSharedPointer>
 #include <QVariant>
@@ -82,7 +83,7 @@ class AccountList : public QAbstractListModel {
     MinecraftAccountPtr getAccountByProfileName(const QString& profileName) const;
     QStringList profileNames() const;
 
-    // requesting a refresh pushes it to the front of the queue
+    // requesting a refresh pushes it to the front of the queue and starts it as soon as a slot is free
     void requestRefresh(QString accountId);
     // queuing a refresh will let it go to the back of the queue (unless it's somewhere inside the queue already)
     void queueRefresh(QString accountId);
@@ -144,8 +145,8 @@ class AccountList : public QAbstractListModel {
    protected:
     QList<QString> m_refreshQueue;
     QTimer* m_refreshTimer;
-    QTimer* m_nextTimer;
-    shared_qobject_ptr<AuthFlow> m_currentTask;
+    // background refreshes in progress, by account internal ID
+    QHash<QString, shared_qobject_ptr<AuthFlow>> m_currentTasks;
 
     /*!
      * Called whenever the list changes.
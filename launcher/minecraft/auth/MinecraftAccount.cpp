@@ -62,6 +62,10 @@ MinecraftAccountPtr MinecraftAccount::loadFromJsonV3(const QJsonObject& json)
 {
     MinecraftAccountPtr account(new MinecraftAccount());
     if (account->data.resumeStateFromV3(json)) {
+        // a token that stays valid for a while is used as is, launching doesn't have to wait for a refresh
+        if (account->data.type == AccountType::MSA && account->data.validity_ == Validity::Assumed && !account->shouldRefresh()) {
+            account->data.accountState = AccountState::Online;
+        }
         return account;
     }
     return nullptr;
@@ -202,23 +206,21 @@ bool MinecraftAccount::shouldRefresh() const
 {
     /*
      * Never refresh accounts that are being used by the game, it breaks the game session.
-     * Always refresh accounts that have not been refreshed yet during this session.
      * Don't refresh broken accounts.
+     * Accounts that have not been refreshed yet during this session are trusted as long as their token is.
      * Refresh accounts that would expire in the next 12 hours (fresh token validity is 24 hours).
      */
     if (isInUse()) {
         return false;
     }
     switch (data.validity_) {
-        case Validity::Certain: {
+        case Validity::Certain:
+        case Validity::Assumed: {
             break;
         }
         case Validity::None: {
             return false;
         }
-        case Validity::Assumed: {
-            return true;
-        }
     }
     auto now = QDateTime::currentDateTimeUtc();
     auto issuedTimestamp = data.yggdrasilToken.issueInstant;
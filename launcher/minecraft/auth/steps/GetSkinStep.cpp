@@ -1,6 +1,6 @@
-
 #include "GetSkinStep.h"
 
+#include <QFile>
 #include <QNetworkRequest>
 
 #include "Application.h"
@@ -15,9 +15,19 @@ QString GetSkinStep::describe()
 void GetSkinStep::perform()
 {
     QUrl url(m_data->minecraftProfile.skin.url);
-
-    m_response.reset(new QByteArray());
-    m_request = Net::Download::makeByteArray(url, m_response);
+    if (!url.isValid() || url.isEmpty()) {
+        emit finished(AccountTaskState::STATE_WORKING, tr("No skin to get"));
+        return;
+    }
+
+    // texture urls end in the hash of the texture, so a cached copy of one never goes out of date
+    m_entry = APPLICATION->metacache()->resolveEntry("skins", url.host() + url.path());
+    if (!m_entry->isStale() && loadCached()) {
+        emit finished(AccountTaskState::STATE_WORKING, tr("Got skin"));
+        return;
+    }
+    m_entry->setStale(true);
+    m_request = Net::Download::makeCached(url, m_entry);
 
     m_task.reset(new NetJob("GetSkinStep", APPLICATION->network()));
     m_task->setAskRetry(false);
@@ -28,9 +38,18 @@ void GetSkinStep::perform()
     m_task->start();
 }
 
+bool GetSkinStep::loadCached()
+{
+    QFile file(m_entry->getFullPath());
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    m_data->minecraftProfile.skin.data = file.readAll();
+    return true;
+}
+
 void GetSkinStep::onRequestDone()
 {
     if (m_request->error() == QNetworkReply::NoError)
-        m_data->minecraftProfile.skin.data = *m_response;
+        loadCached();
     emit finished(AccountTaskState::STATE_WORKING, tr("Got skin"));
 }
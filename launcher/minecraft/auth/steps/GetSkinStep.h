@@ -4,6 +4,7 @@
 
 #include "minecraft/auth/AuthStep.h"
 #include "net/Download.h"
+#include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 
 class GetSkinStep : public AuthStep {
@@ -21,7 +22,10 @@ class GetSkinStep : public AuthStep {
     void onRequestDone();
 
    private:
-    std::shared_ptr<QByteArray> m_response;
+    bool loadCached();
+
+   private:
+    MetaEntryPtr m_entry;
     Net::Download::Ptr m_request;
     NetJob::Ptr m_task;
 };
@@ -19,9 +19,17 @@
 
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
+#include <QCryptographicHash>
+#include <QDebug>
 #include <QDir>
+#include <QDirIterator>
+#include <QMap>
+#include <QUuid>
+#include <algorithm>
+#include <optional>
 #include "FileSystem.h"
 #include "MMCZip.h"
+#include "modplatform/helpers/HashUtils.h"
 
 #ifdef major
 #undef major
@@ -67,6 +75,215 @@ static bool unzipNatives(QString source, QString targetFolder, bool applyJnilibH
     return true;
 }
 
+/**
+ * Natives are extracted once into a cache shared by all instances, one folder per native jar hash and jnilib hack flag.
+ * The instance natives folder is then populated with copies of the cached files.
+ */
+static QString nativesCacheRoot()
+{
+    return QDir("cache/natives").absolutePath();
+}
+
+static qint64 modificationTime(const QFileInfo& info)
+{
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+/** Hashes the native jar, unless it still has the size and timestamp it had when it was last hashed. */
+static QString nativeJarHash(const QString& source)
+{
+    QFileInfo info(source);
+    auto stampPath = FS::PathCombine(nativesCacheRoot(), "jars",
+                                     QCryptographicHash::hash(info.absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex());
+    auto stamp = QString("%1 %2 ").arg(info.size()).arg(modificationTime(info));
+    if (QFileInfo::exists(stampPath)) {
+        try {
+            auto stored = QString::fromUtf8(FS::read(stampPath));
+            if (stored.startsWith(stamp)) {
+                return stored.mid(stamp.size());
+            }
+        } catch (const FS::FileSystemException& e) {
+            qWarning() << "Failed to read native jar hash:" << e.cause();
+        }
+    }
+
+    auto hash = Hashing::hash(source, Hashing::Algorithm::Sha1);
+    if (hash.isEmpty()) {
+        return {};
+    }
+    try {
+        FS::write(stampPath, (stamp + hash).toUtf8());
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to store native jar hash:" << e.cause();
+    }
+    return hash;
+}
+
+static QString cachedNativesPath(const QString& source, bool applyJnilibHack)
+{
+    auto hash = nativeJarHash(source);
+    if (hash.isEmpty()) {
+        return {};
+    }
+    return FS::PathCombine(nativesCacheRoot(), hash + (applyJnilibHack ? "-jnilib" : ""));
+}
+
+namespace {
+struct NativeFile {
+    QString path;  // relative to the natives folder
+    qint64 size;
+    qint64 mtime;  // of this copy of the file, so unchanged files are recognized without hashing them
+    QString sha1;
+
+    bool sameContent(const NativeFile& other) const { return path == other.path && size == other.size && sha1 == other.sha1; }
+};
+}  // namespace
+
+static QByteArray writeManifest(const QList<NativeFile>& files)
+{
+    QStringList lines;
+    for (const auto& file : files) {
+        lines.append(QString("%1 %2 %3 %4").arg(file.sha1).arg(file.size).arg(file.mtime).arg(file.path));
+    }
+    return lines.join('\n').toUtf8();
+}
+
+static bool sameContent(const QList<NativeFile>& a, const QList<NativeFile>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const NativeFile& x, const NativeFile& y) { return x.sameContent(y); });
+}
+
+static std::optional<QList<NativeFile>> readManifest(const QString& manifestPath)
+{
+    if (!QFileInfo::exists(manifestPath)) {
+        return {};
+    }
+    QByteArray data;
+    try {
+        data = FS::read(manifestPath);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to read natives manifest:" << e.cause();
+        return {};
+    }
+    QList<NativeFile> files;
+    for (const auto& line : QString::fromUtf8(data).split('\n', Qt::SkipEmptyParts)) {
+        auto parts = line.split(' ');
+        if (parts.size() < 4) {
+            return {};
+        }
+        bool sizeOk, mtimeOk;
+        auto size = parts[1].toLongLong(&sizeOk);
+        auto mtime = parts[2].toLongLong(&mtimeOk);
+        if (!sizeOk || !mtimeOk) {
+            return {};
+        }
+        // the path is last and may contain spaces itself
+        files.append({ parts.mid(3).join(' '), size, mtime, parts[0] });
+    }
+    return files;
+}
+
+/** Checks that every file listed is in the folder, unmodified.
+ *  Files are only hashed when their timestamp differs from the one listed.
+ */
+static bool matchesManifest(const QString& root, const QList<NativeFile>& files)
+{
+    for (const auto& file : files) {
+        auto path = FS::PathCombine(root, file.path);
+        QFileInfo info(path);
+        if (!info.isFile() || info.size() != file.size) {
+            return false;
+        }
+        if (modificationTime(info) != file.mtime && Hashing::hash(path, Hashing::Algorithm::Sha1) != file.sha1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::optional<QList<NativeFile>> validCachedNatives(const QString& cachedPath)
+{
+    auto files = readManifest(FS::PathCombine(cachedPath, ".complete"));
+    if (files && matchesManifest(cachedPath, *files)) {
+        return files;
+    }
+    return {};
+}
+
+static std::optional<QList<NativeFile>> ensureCachedNatives(const QString& source, const QString& cachedPath, bool applyJnilibHack)
+{
+    // the manifest is written last, so a half extracted folder is never picked up
+    if (auto files = validCachedNatives(cachedPath)) {
+        return files;
+    }
+    if (QFileInfo::exists(cachedPath)) {
+        qWarning() << "Natives cache" << cachedPath << "does not match its manifest, extracting it again";
+    }
+
+    // a unique name keeps launchers extracting the same natives at once from writing into each other's folder
+    auto tempPath = QString("%1.%2.tmp").arg(cachedPath, QUuid::createUuid().toString(QUuid::Id128));
+    if (!FS::ensureFolderPathExists(tempPath) || !unzipNatives(source, tempPath, applyJnilibHack)) {
+        FS::deletePath(tempPath);
+        return {};
+    }
+
+    QList<NativeFile> files;
+    QDir tempDir(tempPath);
+    QDirIterator it(tempPath, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        auto path = it.next();
+        auto info = it.fileInfo();
+        auto sha1 = Hashing::hash(path, Hashing::Algorithm::Sha1);
+        files.append({ tempDir.relativeFilePath(path), info.size(), modificationTime(info), sha1 });
+    }
+    try {
+        FS::write(FS::PathCombine(tempPath, ".complete"), writeManifest(files));
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to mark natives cache as complete:" << e.cause();
+        FS::deletePath(tempPath);
+        return {};
+    }
+
+    // another launcher may have finished the same extraction in the meantime
+    if (auto existing = validCachedNatives(cachedPath)) {
+        FS::deletePath(tempPath);
+        return existing;
+    }
+    FS::deletePath(cachedPath);
+    if (!QDir().rename(tempPath, cachedPath)) {
+        FS::deletePath(tempPath);
+        return validCachedNatives(cachedPath);
+    }
+    return files;
+}
+
+/** Copies the cached natives into the output folder, and records the timestamps the copies got in `copied`. */
+static bool copyCachedNatives(const QString& cachedPath,
+                              const QList<NativeFile>& files,
+                              const QString& outputPath,
+                              QMap<QString, NativeFile>& copied)
+{
+    // never hardlinked: the game may write to its natives, which must not change them for every other instance
+    bool canClone = FS::canClone(cachedPath, outputPath);
+    for (const auto& file : files) {
+        auto srcPath = FS::PathCombine(cachedPath, file.path);
+        auto dstPath = FS::PathCombine(outputPath, file.path);
+        FS::ensureFilePathExists(dstPath);
+        // later jars override files of the earlier ones, same as plain extraction did
+        QFile::remove(dstPath);
+
+        std::error_code ec;
+        if (!(canClone && FS::clone_file(srcPath, dstPath, ec)) && !QFile::copy(srcPath, dstPath)) {
+            qWarning() << "Failed to copy native" << srcPath << "to" << dstPath;
+            return false;
+        }
+        auto copy = file;
+        copy.mtime = modificationTime(QFileInfo(dstPath));
+        copied.insert(copy.path, copy);
+    }
+    return true;
+}
+
 void ExtractNatives::executeTask()
 {
     auto instance = m_parent->instance();
@@ -78,23 +295,54 @@ void ExtractNatives::executeTask()
     auto settings = instance->settings();
 
     auto outputPath = instance->getNativePath();
-    FS::ensureFolderPathExists(outputPath);
     auto javaVersion = instance->getJavaVersion();
     bool jniHackEnabled = javaVersion.major() >= 8;
+
+    QList<std::pair<QString, QList<NativeFile>>> cached;
+    QMap<QString, NativeFile> combined;
     for (const auto& source : toExtract) {
-        if (!unzipNatives(source, outputPath, jniHackEnabled)) {
+        auto cachedPath = cachedNativesPath(source, jniHackEnabled);
+        auto files = cachedPath.isEmpty() ? std::nullopt : ensureCachedNatives(source, cachedPath, jniHackEnabled);
+        if (!files) {
             const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
-            emit logLine(QString(reason).arg(source, outputPath), MessageLevel::Fatal);
-            emitFailed(tr(reason).arg(source, outputPath));
+            emit logLine(QString(reason).arg(source, cachedPath), MessageLevel::Fatal);
+            emitFailed(tr(reason).arg(source, cachedPath));
+            return;
         }
+        for (const auto& file : *files) {
+            combined.insert(file.path, file);
+        }
+        cached.append({ cachedPath, *files });
+    }
+
+    // the manifest records the files the natives folder was built with, they are checked in case the game changed any of them
+    auto manifestPath = FS::PathCombine(outputPath, ".manifest");
+    auto current = readManifest(manifestPath);
+    if (current && sameContent(*current, combined.values()) && matchesManifest(outputPath, *current)) {
+        emitSucceeded();
+        return;
+    }
+
+    FS::deletePath(outputPath);
+    FS::ensureFolderPathExists(outputPath);
+    QMap<QString, NativeFile> copied;
+    for (const auto& [cachedPath, files] : cached) {
+        if (!copyCachedNatives(cachedPath, files, outputPath, copied)) {
+            const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
+            emit logLine(QString(reason).arg(cachedPath, outputPath), MessageLevel::Fatal);
+            emitFailed(tr(reason).arg(cachedPath, outputPath));
+            return;
+        }
+    }
+    try {
+        FS::write(manifestPath, writeManifest(copied.values()));
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write natives manifest:" << e.cause();
     }
     emitSucceeded();
 }
 
 void ExtractNatives::finalize()
 {
-    auto instance = m_parent->instance();
-    QString target_dir = FS::PathCombine(instance->instanceRoot(), "natives/");
-    QDir dir(target_dir);
-    dir.removeRecursively();
+    // the natives folder is kept, its manifest lets the next launch skip copying
 }
@@ -34,55 +34,121 @@
  */
 
 #include "ModMinecraftJar.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDirIterator>
 #include "FileSystem.h"
 #include "MMCZip.h"
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
+#include "minecraft/mod/Mod.h"
+#include "modplatform/helpers/HashUtils.h"
+
+// bump this whenever the way the modded jar is built changes, so old cached jars get rebuilt
+static const QByteArray s_jarKeyFormat = "1";
 
 void ModMinecraftJar::executeTask()
 {
     auto m_inst = m_parent->instance();
 
     if (!m_inst->getJarMods().size()) {
+        // no jar mods, nothing should be left behind from previous launches
+        removeJar();
         emitSucceeded();
         return;
     }
-    // nuke obsolete stripped jar(s) if needed
     if (!FS::ensureFolderPathExists(m_inst->binRoot())) {
         emitFailed(tr("Couldn't create the bin folder for Minecraft.jar"));
+        return;
     }
 
     auto finalJarPath = QDir(m_inst->binRoot()).absoluteFilePath("minecraft.jar");
-    if (!removeJar()) {
-        emitFailed(tr("Couldn't remove stale jar file: %1").arg(finalJarPath));
-    }
 
     // create temporary modded jar, if needed
     auto components = m_inst->getPackProfile();
     auto profile = components->getProfile();
     auto jarMods = m_inst->getJarMods();
-    if (jarMods.size()) {
-        auto mainJar = profile->getMainJar();
-        QStringList jars, temp1, temp2, temp3, temp4;
-        mainJar->getApplicableFiles(m_inst->runtimeContext(), jars, temp1, temp2, temp3, m_inst->getLocalLibraryPath());
-        auto sourceJarPath = jars[0];
-        if (!MMCZip::createModdedJar(sourceJarPath, finalJarPath, jarMods)) {
-            emitFailed(tr("Failed to create the custom Minecraft jar file."));
-            return;
-        }
+    auto mainJar = profile->getMainJar();
+    QStringList jars, temp1, temp2, temp3, temp4;
+    mainJar->getApplicableFiles(m_inst->runtimeContext(), jars, temp1, temp2, temp3, m_inst->getLocalLibraryPath());
+    auto sourceJarPath = jars[0];
+
+    auto key = jarKey(sourceJarPath, jarMods);
+    if (QFileInfo::exists(finalJarPath) && QFileInfo::exists(keyPath()) && FS::read(keyPath()) == key) {
+        emit logLine(tr("Modded Minecraft jar is up to date, skipping rebuild."), MessageLevel::Launcher);
+        emitSucceeded();
+        return;
+    }
+
+    // nuke obsolete modded jar
+    if (!removeJar()) {
+        emitFailed(tr("Couldn't remove stale jar file: %1").arg(finalJarPath));
+        return;
+    }
+
+    if (!MMCZip::createModdedJar(sourceJarPath, finalJarPath, jarMods)) {
+        emitFailed(tr("Failed to create the custom Minecraft jar file."));
+        return;
+    }
+
+    try {
+        FS::write(keyPath(), key);
+    } catch (const FS::FileSystemException& e) {
+        // not fatal, the jar will just be rebuilt on the next launch
+        qWarning() << "Failed to save the modded jar key:" << e.cause();
     }
     emitSucceeded();
 }
 
 void ModMinecraftJar::finalize()
 {
-    removeJar();
+    // the modded jar is kept around and reused by the next launch as long as its inputs do not change
+}
+
+QString ModMinecraftJar::keyPath() const
+{
+    return QDir(m_parent->instance()->binRoot()).absoluteFilePath("minecraft.jar.key");
+}
+
+QByteArray ModMinecraftJar::jarKey(const QString& sourceJarPath, const QList<Mod*>& jarMods) const
+{
+    // ordered list of the inputs, the order matters as earlier entries win over later ones
+    QByteArray key = "format " + s_jarKeyFormat + "\n";
+    key += "jar " + Hashing::hash(sourceJarPath, Hashing::Algorithm::Sha1).toUtf8() + "\n";
+    for (auto mod : jarMods) {
+        if (!mod->enabled())
+            continue;
+        auto info = mod->fileinfo();
+        key += QByteArray::number(static_cast<int>(mod->type())) + " " + info.fileName().toUtf8() + " ";
+        if (mod->type() == ResourceType::FOLDER) {
+            // folders are not hashed in full, their listing with sizes and timestamps is enough to detect changes
+            QCryptographicHash hash(QCryptographicHash::Sha1);
+            QDirIterator it(info.absoluteFilePath(), QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+            QStringList entries;
+            while (it.hasNext()) {
+                it.next();
+                auto entry = it.fileInfo();
+                entries << QString("%1:%2:%3").arg(entry.filePath()).arg(entry.size()).arg(entry.lastModified().toMSecsSinceEpoch());
+            }
+            entries.sort();
+            hash.addData(entries.join('\n').toUtf8());
+            key += hash.result().toHex();
+        } else {
+            key += Hashing::hash(info.absoluteFilePath(), Hashing::Algorithm::Sha1).toUtf8();
+        }
+        key += "\n";
+    }
+    return key;
 }
 
 bool ModMinecraftJar::removeJar()
 {
     auto m_inst = m_parent->instance();
+    QFile key(keyPath());
+    if (key.exists() && !key.remove()) {
+        return false;
+    }
     auto finalJarPath = QDir(m_inst->binRoot()).absoluteFilePath("minecraft.jar");
     QFile finalJar(finalJarPath);
     if (finalJar.exists()) {
@@ -18,6 +18,8 @@
 #include <launch/LaunchStep.h>
 #include <memory>
 
+class Mod;
+
 class ModMinecraftJar : public LaunchStep {
     Q_OBJECT
    public:
@@ -30,4 +32,10 @@ class ModMinecraftJar : public LaunchStep {
 
    private:
     bool removeJar();
+    QString keyPath() const;
+    /**
+     * Identifies the inputs of the modded jar: the hash of the vanilla jar and of every enabled jar mod, in order.
+     * The jar is only rebuilt when this changes.
+     */
+    QByteArray jarKey(const QString& sourceJarPath, const QList<Mod*>& jarMods) const;
 };
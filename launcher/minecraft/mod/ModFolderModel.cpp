@@ -239,6 +239,8 @@ Task* ModFolderModel::createUpdateTask()
 {
     auto index_dir = indexDir();
     auto task = new ModFolderLoadTask(dir(), index_dir, m_is_indexed, m_first_folder_load);
+    // whatever is written to the index from now on is only seen by the next load
+    m_index_modified = QFileInfo(index_dir.absolutePath()).lastModified();
     m_first_folder_load = false;
     return task;
 }
@@ -248,6 +250,42 @@ Task* ModFolderModel::createParseTask(Resource& resource)
     return new LocalModParseTask(m_next_resolution_ticket, resource.type(), resource.fileinfo());
 }
 
+Resource::Ptr ModFolderModel::createResource(const QFileInfo& file)
+{
+    auto mod = makeShared<Mod>(file);
+    mod->setStatus(ModStatus::NoMetadata);
+    return mod;
+}
+
+bool ModFolderModel::applyChanges(const QString& path, const QList<FileWatcher::Change>& changes)
+{
+    auto index_dir = indexDir();
+    if (path == index_dir.absolutePath())
+        return false;
+
+    // mods with metadata are paired with their .index entry by the load task, so leave those to a full update
+    bool index_changed = m_is_indexed && QFileInfo(index_dir.absolutePath()).lastModified() != m_index_modified;
+    for (auto const& change : changes) {
+        auto name = QFileInfo(change.path).fileName();
+        if (name == ".index")
+            return false;
+        auto other = name.endsWith(".disabled") ? name.chopped(9) : name + ".disabled";
+        bool known = false;
+        for (auto const& id : { name, other }) {
+            auto row = m_resources_index.constFind(id);
+            if (row == m_resources_index.constEnd())
+                continue;
+            if (at(row.value())->metadata())
+                return false;
+            known = true;
+        }
+        // the index may have gained an entry for this new file since the last load
+        if (!known && index_changed && change.kind != FileWatcher::Change::Removed)
+            return false;
+    }
+    return ResourceFolderModel::applyChanges(path, changes);
+}
+
 bool ModFolderModel::uninstallMod(const QString& filename, bool preserve_metadata)
 {
     for (auto mod : allMods()) {
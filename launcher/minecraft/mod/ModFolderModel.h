@@ -38,6 +38,7 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QDateTime>
 #include <QDir>
 #include <QList>
 #include <QMap>
@@ -88,6 +89,7 @@ class ModFolderModel : public ResourceFolderModel {
 
     [[nodiscard]] Task* createUpdateTask() override;
     [[nodiscard]] Task* createParseTask(Resource&) override;
+    [[nodiscard]] Resource::Ptr createResource(const QFileInfo& file) override;
 
     bool installMod(QString file_path) { return ResourceFolderModel::installResource(file_path); }
     bool installMod(QString file_path, ModPlatform::IndexedVersion& vers);
@@ -114,6 +116,10 @@ class ModFolderModel : public ResourceFolderModel {
     void onParseSucceeded(int ticket, QString resource_id) override;
 
    protected:
+    bool applyChanges(const QString& path, const QList<FileWatcher::Change>& changes) override;
+
     bool m_is_indexed;
     bool m_first_folder_load = true;
+    // last modification of the .index folder when the current rows were loaded
+    QDateTime m_index_modified;
 };
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PackThumbnail.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QImageReader>
+#include <QSaveFile>
+
+#include <mutex>
+
+#include "Application.h"
+#include "FileSystem.h"
+
+namespace PackThumbnail {
+
+namespace {
+// a thumbnail unused for this long most likely belongs to a pack that was removed or replaced
+const int MAX_AGE_DAYS = 30;
+// how stale the timestamp of a used thumbnail may get before it's refreshed, so loads rarely have to write
+const int TOUCH_AFTER_DAYS = 1;
+
+// drops the expired thumbnails, once per run
+void prune(const QString& dir)
+{
+    static std::once_flag s_pruned;
+    std::call_once(s_pruned, [&dir] {
+        auto expiry = QDateTime::currentDateTime().addDays(-MAX_AGE_DAYS);
+        for (auto& entry : QDir(dir).entryInfoList({ "*.png" }, QDir::Files)) {
+            if (entry.lastModified() < expiry && !QFile::remove(entry.absoluteFilePath()))
+                qWarning() << "Failed to remove expired pack thumbnail" << entry.absoluteFilePath();
+        }
+    });
+}
+
+// hashing the archive itself would mean reading all of it, so identify its contents by where it is, how big it is and when it changed
+QString cachePath(const QFileInfo& pack)
+{
+    auto app = APPLICATION_DYN;  // in tests the application macro doesn't work
+    if (!app || !pack.isFile())
+        return {};
+
+    auto dir = FS::PathCombine(app->dataRoot(), "cache", "pack_thumbnails");
+    prune(dir);
+
+    // enabling or disabling a pack renames it without touching its contents, so that keeps the same thumbnail
+    auto path = pack.absoluteFilePath();
+    if (path.endsWith(".disabled"))
+        path.chop(9);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(path.toUtf8());
+    hash.addData(QByteArray::number(pack.size()));
+    hash.addData(QByteArray::number(pack.lastModified().toMSecsSinceEpoch()));
+    return FS::PathCombine(dir, QString::fromLatin1(hash.result().toHex()) + ".png");
+}
+}  // namespace
+
+QImage decode(const QByteArray& data)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    // same size ResourcePack::setImage used to scale down to, but asked of the decoder up front
+    auto size = reader.size();
+    if (size.isValid() && (size.width() > SIZE || size.height() > SIZE))
+        reader.setScaledSize(size.scaled(SIZE, SIZE, Qt::KeepAspectRatioByExpanding));
+
+    auto image = reader.read();
+    if (image.isNull())
+        qWarning() << "Failed to decode pack image:" << reader.errorString();
+    return image;
+}
+
+QImage load(const QFileInfo& pack)
+{
+    auto path = cachePath(pack);
+    if (path.isEmpty() || !QFileInfo::exists(path))
+        return {};
+
+    QImage image;
+    if (!image.load(path, "PNG")) {
+        qWarning() << "Ignoring unreadable pack thumbnail" << path;
+        return image;
+    }
+
+    // keep thumbnails that are still in use from expiring
+    auto now = QDateTime::currentDateTime();
+    if (QFileInfo(path).lastModified() < now.addDays(-TOUCH_AFTER_DAYS)) {
+        QFile file(path);
+        if (file.open(QIODevice::ReadWrite))
+            file.setFileTime(now, QFileDevice::FileModificationTime);
+    }
+    return image;
+}
+
+void store(const QFileInfo& pack, const QImage& thumbnail)
+{
+    auto path = cachePath(pack);
+    if (path.isEmpty() || thumbnail.isNull() || !FS::ensureFilePathExists(path))
+        return;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || !thumbnail.save(&file, "PNG") || !file.commit())
+        qWarning() << "Failed to store pack thumbnail" << path << ":" << file.errorString();
+}
+
+}  // namespace PackThumbnail
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFileInfo>
+#include <QImage>
+
+/** Small, disk-cached versions of the pack.png shipped by resource and texture packs.
+ *  Thumbnails that go unused for a month are removed from the disk cache.
+ */
+namespace PackThumbnail {
+
+/// Pack images are never shown bigger than this, so that is all we decode and keep
+constexpr int SIZE = 64;
+
+/** Decodes an image straight to thumbnail size, so large pack.png files never get fully expanded in memory. */
+QImage decode(const QByteArray& data);
+
+/** Gets the thumbnail stored for the pack archive, or a null image if there is none for its current contents. */
+QImage load(const QFileInfo& pack);
+/** Stores the thumbnail of the pack archive, so the next load doesn't have to open it. */
+void store(const QFileInfo& pack, const QImage& thumbnail);
+
+}  // namespace PackThumbnail
@@ -33,7 +33,7 @@ ResourceFolderModel::ResourceFolderModel(QDir dir, BaseInstance* instance, QObje
     m_dir.setFilter(QDir::Readable | QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
     m_dir.setSorting(QDir::Name | QDir::IgnoreCase | QDir::LocaleAware);
 
-    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ResourceFolderModel::directoryChanged);
+    connect(&m_watcher, &FileWatcher::changed, this, &ResourceFolderModel::directoryChanged);
     connect(&m_helper_thread_task, &ConcurrentTask::finished, this, [this] { m_helper_thread_task.clear(); });
     if (APPLICATION_DYN) {  // in tests the application macro doesn't work
         m_helper_thread_task.setMaxConcurrent(APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
@@ -329,7 +329,7 @@ void ResourceFolderModel::onParseSucceeded(int ticket, QString resource_id)
 
 Task* ResourceFolderModel::createUpdateTask()
 {
-    return new BasicFolderLoadTask(m_dir);
+    return new BasicFolderLoadTask(m_dir, [this](QFileInfo const& entry) { return createResource(entry); });
 }
 
 bool ResourceFolderModel::hasPendingParseTasks() const
@@ -337,9 +337,119 @@ bool ResourceFolderModel::hasPendingParseTasks() const
     return !m_active_parse_tasks.isEmpty();
 }
 
-void ResourceFolderModel::directoryChanged(QString path)
+void ResourceFolderModel::directoryChanged(const QString& path, const QList<FileWatcher::Change>& changes)
 {
-    update();
+    // a running update will pick these changes up, or miss half of them, so let it run again instead
+    if (m_current_update_task || !applyChanges(path, changes)) {
+        update();
+        return;
+    }
+    emit updateFinished();
+}
+
+bool ResourceFolderModel::applyChanges(const QString& path, const QList<FileWatcher::Change>& changes)
+{
+    if (path != m_dir.absolutePath())
+        return false;
+
+    QStringList removed;
+    QList<QFileInfo> touched;
+    for (auto const& change : changes) {
+        // the watcher couldn't tell what changed, or the folder itself went away
+        if (change.path == path)
+            return false;
+        if (auto app = APPLICATION_DYN; app && app->checkQSavePath(change.path))
+            continue;
+
+        QFileInfo file(change.path);
+        // skip what the update task doesn't list either
+        if (!(m_dir.filter() & QDir::Hidden) && file.isHidden())
+            continue;
+        if (change.kind == FileWatcher::Change::Removed || !file.exists()) {
+            if (m_resources_index.contains(file.fileName()))
+                removed.append(file.fileName());
+            continue;
+        }
+        if ((m_dir.filter() & QDir::Readable) && !file.isReadable())
+            continue;
+
+        // same as the update task, this move comes back as another change
+        auto unique_path = FS::getUniqueResourceName(file.absoluteFilePath());
+        if (unique_path != file.absoluteFilePath()) {
+            FS::move(file.absoluteFilePath(), unique_path);
+            continue;
+        }
+        touched.append(file);
+    }
+
+    auto abortResolving = [this](Resource const& resource) {
+        if (!resource.isResolving())
+            return;
+        auto task = m_active_parse_tasks.constFind(resource.resolutionTicket());
+        if (task != m_active_parse_tasks.constEnd())
+            (*task)->abort();
+    };
+
+    for (auto const& file : touched) {
+        auto id = file.fileName();
+        auto row_it = m_resources_index.constFind(id);
+        if (row_it != m_resources_index.constEnd()) {
+            // modified in place
+            auto row = row_it.value();
+            if (m_resources.at(row)->dateTimeChanged() == file.lastModified())
+                continue;
+            abortResolving(*m_resources.at(row));
+            m_resources[row].reset(createResource(file));
+            resolveResource(m_resources.at(row));
+            emit dataChanged(index(row, 0), index(row, columnCount(QModelIndex()) - 1));
+            continue;
+        }
+
+        // a rename keeps the file's timestamp and size, so move the row over and keep what was parsed already
+        auto renamed = std::find_if(removed.begin(), removed.end(), [this, &file](QString const& old_id) {
+            auto const& resource = m_resources.at(m_resources_index.value(old_id));
+            return resource->dateTimeChanged() == file.lastModified() && resource->fileinfo().size() == file.size() &&
+                   resource->fileinfo().isDir() == file.isDir();
+        });
+        if (renamed != removed.end()) {
+            auto row = m_resources_index.take(*renamed);
+            removed.erase(renamed);
+            m_resources.at(row)->setFile(file);
+            m_resources_index[m_resources.at(row)->internal_id()] = row;
+            emit dataChanged(index(row, 0), index(row, columnCount(QModelIndex()) - 1));
+            continue;
+        }
+
+        auto row = static_cast<int>(m_resources.size());
+        beginInsertRows(QModelIndex(), row, row);
+        m_resources.append(createResource(file));
+        m_resources_index[m_resources.last()->internal_id()] = row;
+        resolveResource(m_resources.last());
+        endInsertRows();
+    }
+
+    if (!removed.isEmpty()) {
+        QList<int> removed_rows;
+        for (auto const& id : removed)
+            removed_rows.append(m_resources_index.value(id));
+        std::sort(removed_rows.begin(), removed_rows.end(), std::greater<int>());
+
+        for (auto row : removed_rows) {
+            abortResolving(*m_resources.at(row));
+            beginRemoveRows(QModelIndex(), row, row);
+            m_resources.removeAt(row);
+            endRemoveRows();
+        }
+
+        m_resources_index.clear();
+        int idx = 0;
+        for (auto const& resource : qAsConst(m_resources)) {
+            m_resources_index[resource->internal_id()] = idx;
+            idx++;
+        }
+    }
+
+    return true;
 }
 
 Qt::DropActions ResourceFolderModel::supportedDropActions() const
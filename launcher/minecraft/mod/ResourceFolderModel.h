@@ -3,7 +3,6 @@
 #include <QAbstractListModel>
 #include <QAction>
 #include <QDir>
-#include <QFileSystemWatcher>
 #include <QHeaderView>
 #include <QMutex>
 #include <QSet>
@@ -13,6 +12,7 @@
 #include "Resource.h"
 
 #include "BaseInstance.h"
+#include "FileWatcher.h"
 
 #include "tasks/ConcurrentTask.h"
 #include "tasks/Task.h"
@@ -155,6 +155,12 @@ class ResourceFolderModel : public QAbstractListModel {
      */
     [[nodiscard]] virtual Task* createUpdateTask();
 
+    /** This creates the resource for an entry of the folder, both for the update task and when applying watcher changes.
+     *
+     *  It may be called from the update task's thread, so it should only construct the resource.
+     */
+    [[nodiscard]] virtual Resource::Ptr createResource(const QFileInfo& file) { return makeShared<Resource>(file); }
+
     /** This creates a new parse task to be executed by onUpdateSucceeded().
      *
      *  This task should load and parse all heavy info needed by a resource, such as parsing a manifest. It gets executed
@@ -172,8 +178,15 @@ class ResourceFolderModel : public QAbstractListModel {
     template <typename T>
     void applyUpdates(QSet<QString>& current_set, QSet<QString>& new_set, QMap<QString, T>& new_resources);
 
+    /** Applies the changes the watcher saw in 'path' to the affected rows only, without listing the folder again.
+     *
+     *  Renamed resources keep their parsed data, and only new or modified ones get parsed.
+     *  Returns false if the changes can't be applied that way, in which case a full update() is done instead.
+     */
+    virtual bool applyChanges(const QString& path, const QList<FileWatcher::Change>& changes);
+
    protected slots:
-    void directoryChanged(QString);
+    void directoryChanged(const QString& path, const QList<FileWatcher::Change>& changes);
 
     /** Called when the update task is successful.
      *
@@ -205,7 +218,7 @@ class ResourceFolderModel : public QAbstractListModel {
 
     QDir m_dir;
     BaseInstance* m_instance;
-    QFileSystemWatcher m_watcher;
+    FileWatcher m_watcher;
     bool m_is_watching = false;
 
     Task::Ptr m_current_update_task = nullptr;
@@ -45,7 +45,6 @@
 #include "Version.h"
 
 #include "minecraft/mod/Resource.h"
-#include "minecraft/mod/tasks/BasicFolderLoadTask.h"
 #include "minecraft/mod/tasks/LocalResourcePackParseTask.h"
 
 ResourcePackFolderModel::ResourcePackFolderModel(const QString& dir, BaseInstance* instance) : ResourceFolderModel(QDir(dir), instance)
@@ -185,11 +184,6 @@ int ResourcePackFolderModel::columnCount(const QModelIndex& parent) const
     return parent.isValid() ? 0 : NUM_COLUMNS;
 }
 
-Task* ResourcePackFolderModel::createUpdateTask()
-{
-    return new BasicFolderLoadTask(m_dir, [](QFileInfo const& entry) { return makeShared<ResourcePack>(entry); });
-}
-
 Task* ResourcePackFolderModel::createParseTask(Resource& resource)
 {
     return new LocalResourcePackParseTask(m_next_resolution_ticket, static_cast<ResourcePack&>(resource));
@@ -18,7 +18,7 @@ class ResourcePackFolderModel : public ResourceFolderModel {
     [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
     [[nodiscard]] int columnCount(const QModelIndex& parent) const override;
 
-    [[nodiscard]] Task* createUpdateTask() override;
+    [[nodiscard]] Resource::Ptr createResource(const QFileInfo& file) override { return makeShared<ResourcePack>(file); }
     [[nodiscard]] Task* createParseTask(Resource&) override;
 
     RESOURCE_HELPERS(ResourcePack)
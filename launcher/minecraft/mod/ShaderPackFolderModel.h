@@ -2,7 +2,6 @@
 
 #include "ResourceFolderModel.h"
 #include "minecraft/mod/ShaderPack.h"
-#include "minecraft/mod/tasks/BasicFolderLoadTask.h"
 #include "minecraft/mod/tasks/LocalShaderPackParseTask.h"
 
 class ShaderPackFolderModel : public ResourceFolderModel {
@@ -13,10 +12,7 @@ class ShaderPackFolderModel : public ResourceFolderModel {
 
     virtual QString id() const override { return "shaderpacks"; }
 
-    [[nodiscard]] Task* createUpdateTask() override
-    {
-        return new BasicFolderLoadTask(m_dir, [](QFileInfo const& entry) { return makeShared<ShaderPack>(entry); });
-    }
+    [[nodiscard]] Resource::Ptr createResource(const QFileInfo& file) override { return makeShared<ShaderPack>(file); }
 
     [[nodiscard]] Task* createParseTask(Resource& resource) override
     {
@@ -39,7 +39,6 @@
 
 #include "TexturePackFolderModel.h"
 
-#include "minecraft/mod/tasks/BasicFolderLoadTask.h"
 #include "minecraft/mod/tasks/LocalTexturePackParseTask.h"
 
 TexturePackFolderModel::TexturePackFolderModel(const QString& dir, BaseInstance* instance) : ResourceFolderModel(QDir(dir), instance)
@@ -52,11 +51,6 @@ TexturePackFolderModel::TexturePackFolderModel(const QString& dir, BaseInstance*
     m_columnsHideable = { false, true, false, true, true };
 }
 
-Task* TexturePackFolderModel::createUpdateTask()
-{
-    return new BasicFolderLoadTask(m_dir, [](QFileInfo const& entry) { return makeShared<TexturePack>(entry); });
-}
-
 Task* TexturePackFolderModel::createParseTask(Resource& resource)
 {
     return new LocalTexturePackParseTask(m_next_resolution_ticket, static_cast<TexturePack&>(resource));
@@ -56,7 +56,7 @@ class TexturePackFolderModel : public ResourceFolderModel {
     [[nodiscard]] int columnCount(const QModelIndex& parent) const override;
 
     explicit TexturePackFolderModel(const QString& dir, BaseInstance* instance);
-    [[nodiscard]] Task* createUpdateTask() override;
+    [[nodiscard]] Resource::Ptr createResource(const QFileInfo& file) override { return makeShared<TexturePack>(file); }
     [[nodiscard]] Task* createParseTask(Resource&) override;
 
     RESOURCE_HELPERS(TexturePack)
@@ -23,12 +23,14 @@
 #include <memory>
 #include "Json.h"
 #include "QObjectPtr.h"
+#include "StringUtils.h"
 #include "minecraft/PackProfile.h"
 #include "minecraft/mod/MetadataHandler.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/ResourceAPI.h"
 #include "modplatform/flame/FlameAPI.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
+#include "tasks/ConcurrentTask.h"
 #include "tasks/SequentialTask.h"
 #include "ui/pages/modplatform/ModModel.h"
 #include "ui/pages/modplatform/flame/FlameResourceModels.h"
@@ -44,6 +46,16 @@ static ModPlatform::ModLoaderTypes mcLoaders(BaseInstance* inst)
     return static_cast<MinecraftInstance*>(inst)->getPackProfile()->getSupportedModLoaders().value();
 }
 
+static QString projectKey(ModPlatform::ResourceProvider provider, const QVariant& addonId)
+{
+    return QString("%1/%2").arg(ModPlatform::ProviderCapabilities::name(provider), addonId.toString());
+}
+
+static QString fileKey(ModPlatform::ResourceProvider provider, const QVariant& fileId)
+{
+    return QString("%1/file/%2").arg(ModPlatform::ProviderCapabilities::name(provider), fileId.toString());
+}
+
 static bool checkDependencies(std::shared_ptr<GetModDependenciesTask::PackDependency> sel,
                               Version mcVersion,
                               ModPlatform::ModLoaderTypes loaders)
@@ -65,10 +77,24 @@ GetModDependenciesTask::GetModDependenciesTask(BaseInstance* instance,
     , m_loaderType(mcLoaders(instance))
 {
     for (auto mod : folder->allMods()) {
-        m_mods_file_names << mod->fileinfo().fileName();
-        if (auto meta = mod->metadata(); meta)
-            m_mods.append(meta);
+        if (auto fileName = mod->fileinfo().fileName(); !fileName.isEmpty()) {
+            m_installed_files.insert(StringUtils::laxName(fileName));
+            m_installed_files_lax.insert(StringUtils::laxName(fileName, true));
+        }
+        if (auto meta = mod->metadata(); meta) {
+            m_installed.insert(projectKey(meta->provider, meta->project_id));
+            m_installed.insert(fileKey(meta->provider, meta->file_id));
+        }
+    }
+    for (auto sel : m_selected) {
+        m_installed.insert(projectKey(sel->pack->provider, sel->pack->addonId));
+        if (!sel->version.fileId.toString().isEmpty())
+            m_installed.insert(fileKey(sel->pack->provider, sel->version.fileId));
+        if (!sel->version.fileName.isEmpty())
+            m_installed_files.insert(StringUtils::laxName(sel->version.fileName));
     }
+    connect(this, &Task::finished, this,
+            [this] { qDebug() << "Resolved" << m_pack_dependencies.size() << "dependencies with" << m_request_count << "requests"; });
     prepare();
 }
 
@@ -77,9 +103,10 @@ void GetModDependenciesTask::prepare()
     for (auto sel : m_selected) {
         if (checkDependencies(sel, m_version, m_loaderType))
             for (auto dep : getDependenciesForVersion(sel->version, sel->pack->provider)) {
-                addTask(prepareDependencyTask(dep, sel->pack->provider, 20));
+                queueDependency(dep, sel->pack->provider, 20);
             }
     }
+    addNextLevel();
 }
 
 ModPlatform::Dependency GetModDependenciesTask::getOverride(const ModPlatform::Dependency& dep,
@@ -101,94 +128,135 @@ QList<ModPlatform::Dependency> GetModDependenciesTask::getDependenciesForVersion
                                                                                  const ModPlatform::ResourceProvider providerName)
 {
     QList<ModPlatform::Dependency> c_dependencies;
+    QSet<QString> c_keys;
     for (auto ver_dep : version.dependencies) {
         if (ver_dep.type != ModPlatform::DependencyType::REQUIRED)
             continue;
         ver_dep = getOverride(ver_dep, providerName);
         auto isOnlyVersion = providerName == ModPlatform::ResourceProvider::MODRINTH && ver_dep.addonId.toString().isEmpty();
-        if (auto dep = std::find_if(c_dependencies.begin(), c_dependencies.end(),
-                                    [&ver_dep, isOnlyVersion](const ModPlatform::Dependency& i) {
-                                        return isOnlyVersion ? i.version == ver_dep.version : i.addonId == ver_dep.addonId;
-                                    });
-            dep != c_dependencies.end())
-            continue;  // check the current dependency list
-
-        if (auto dep = std::find_if(m_selected.begin(), m_selected.end(),
-                                    [&ver_dep, providerName, isOnlyVersion](std::shared_ptr<PackDependency> i) {
-                                        return i->pack->provider == providerName && (isOnlyVersion ? i->version.version == ver_dep.version
-                                                                                                   : i->pack->addonId == ver_dep.addonId);
-                                    });
-            dep != m_selected.end())
-            continue;  // check the selected versions
-
-        if (auto dep = std::find_if(m_mods.begin(), m_mods.end(),
-                                    [&ver_dep, providerName, isOnlyVersion](std::shared_ptr<Metadata::ModStruct> i) {
-                                        return i->provider == providerName &&
-                                               (isOnlyVersion ? i->file_id == ver_dep.version : i->project_id == ver_dep.addonId);
-                                    });
-            dep != m_mods.end())
-            continue;  // check the existing mods
-
-        if (auto dep = std::find_if(m_pack_dependencies.begin(), m_pack_dependencies.end(),
-                                    [&ver_dep, providerName, isOnlyVersion](std::shared_ptr<PackDependency> i) {
-                                        return i->pack->provider == providerName && (isOnlyVersion ? i->version.version == ver_dep.addonId
-                                                                                                   : i->pack->addonId == ver_dep.addonId);
-                                    });
-            dep != m_pack_dependencies.end())  // check loaded dependencies
+        auto key = isOnlyVersion ? fileKey(providerName, ver_dep.version) : projectKey(providerName, ver_dep.addonId);
+
+        // check the current dependency list, the selected versions, the existing mods and the loaded dependencies
+        if (c_keys.contains(key) || m_installed.contains(key) || m_pack_ids.contains(key))
             continue;
 
+        c_keys.insert(key);
         c_dependencies.append(ver_dep);
     }
     return c_dependencies;
 }
 
-Task::Ptr GetModDependenciesTask::getProjectInfoTask(std::shared_ptr<PackDependency> pDep)
+void GetModDependenciesTask::queueDependency(const ModPlatform::Dependency& dep,
+                                             const ModPlatform::ResourceProvider providerName,
+                                             int level)
 {
-    auto provider = pDep->pack->provider == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
+    auto pDep = std::make_shared<PackDependency>();
+    pDep->dependency = dep;
+    pDep->pack = std::make_shared<ModPlatform::IndexedPack>();
+    pDep->pack->addonId = dep.addonId;
+    pDep->pack->provider = providerName;
+
+    m_pack_dependencies.append(pDep);
+    indexPack(pDep);
+    m_pending.append({ pDep, level });
+}
+
+void GetModDependenciesTask::addNextLevel()
+{
+    if (m_pending.isEmpty())
+        return;
+    auto pending = m_pending;
+    m_pending.clear();
+
+    auto versions = makeShared<ConcurrentTask>(tr("Dependency versions"));
+    for (auto& p : pending) {
+        versions->addTask(getVersionTask(p.pack_dep, p.level));
+    }
+    m_request_count += pending.size();
+
+    // connected before this task starts the subtask, so the project info and the next level are queued before it moves on
+    connect(versions.get(), &Task::succeeded, this, [this, pending] {
+        QList<std::shared_ptr<PackDependency>> flame;
+        QList<std::shared_ptr<PackDependency>> modrinth;
+        for (auto& p : pending) {
+            auto pDep = p.pack_dep;
+            auto addonId = pDep->pack->addonId;
+            if (addonId.toString().isEmpty() || m_pack_ids.value(projectKey(pDep->pack->provider, addonId)) != pDep)
+                continue;  // removed while resolving the version
+            (pDep->pack->provider == m_flame_provider.name ? flame : modrinth).append(pDep);
+        }
+        if (!flame.isEmpty())
+            addTask(getProjectsInfoTask(m_flame_provider, flame));
+        if (!modrinth.isEmpty())
+            addTask(getProjectsInfoTask(m_modrinth_provider, modrinth));
+        addNextLevel();
+    });
+    addTask(versions);
+}
+
+Task::Ptr GetModDependenciesTask::getProjectsInfoTask(const Provider& provider, QList<std::shared_ptr<PackDependency>> pDeps)
+{
+    QStringList addonIds;
+    for (auto& pDep : pDeps) {
+        addonIds.append(pDep->pack->addonId.toString());
+    }
     auto responseInfo = std::make_shared<QByteArray>();
-    auto info = provider.api->getProject(pDep->pack->addonId.toString(), responseInfo);
-    QObject::connect(info.get(), &NetJob::succeeded, [this, responseInfo, provider, pDep] {
+    // a single project goes through the cached endpoint
+    auto info = addonIds.size() == 1 ? provider.api->getProject(addonIds.first(), responseInfo)
+                                     : provider.api->getProjects(addonIds, responseInfo);
+    m_request_count++;
+
+    QObject::connect(info.get(), &NetJob::succeeded, [this, responseInfo, provider, pDeps] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*responseInfo, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
-            removePack(pDep->pack->addonId);
+            for (auto& pDep : pDeps) {
+                removePack(pDep);
+            }
             qWarning() << "Error while parsing JSON response for mod info at " << parse_error.offset
                        << " reason: " << parse_error.errorString();
             qDebug() << *responseInfo;
             return;
         }
-        try {
-            auto obj = provider.name == ModPlatform::ResourceProvider::FLAME ? Json::requireObject(Json::requireObject(doc), "data")
-                                                                             : Json::requireObject(doc);
-            provider.mod->loadIndexedPack(*pDep->pack, obj);
-        } catch (const JSONValidationError& e) {
-            removePack(pDep->pack->addonId);
-            qDebug() << doc;
-            qWarning() << "Error while reading mod info: " << e.cause();
+
+        // the bulk endpoints answer with an array, the single project one with the project itself
+        QJsonArray projects;
+        if (provider.name == ModPlatform::ResourceProvider::FLAME) {
+            auto data = doc.object().value("data");
+            projects = data.isArray() ? data.toArray() : QJsonArray{ data };
+        } else {
+            projects = doc.isArray() ? doc.array() : QJsonArray{ doc.object() };
+        }
+
+        QHash<QString, QJsonObject> byId;
+        for (auto project : projects) {
+            auto obj = project.toObject();
+            byId.insert(obj.value("id").toVariant().toString(), obj);
+        }
+
+        for (auto& pDep : pDeps) {
+            auto obj = byId.value(pDep->pack->addonId.toString());
+            if (obj.isEmpty()) {
+                removePack(pDep);
+                qWarning() << "Missing mod info for" << pDep->pack->addonId;
+                continue;
+            }
+            try {
+                provider.mod->loadIndexedPack(*pDep->pack, obj);
+            } catch (const JSONValidationError& e) {
+                removePack(pDep);
+                qDebug() << obj;
+                qWarning() << "Error while reading mod info: " << e.cause();
+            }
         }
     });
     return info;
 }
 
-Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Dependency& dep,
-                                                        const ModPlatform::ResourceProvider providerName,
-                                                        int level)
+Task::Ptr GetModDependenciesTask::getVersionTask(std::shared_ptr<PackDependency> pDep, int level)
 {
-    auto pDep = std::make_shared<PackDependency>();
-    pDep->dependency = dep;
-    pDep->pack = std::make_shared<ModPlatform::IndexedPack>();
-    pDep->pack->addonId = dep.addonId;
-    pDep->pack->provider = providerName;
-
-    m_pack_dependencies.append(pDep);
-    auto provider = providerName == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
-
-    auto tasks = makeShared<SequentialTask>(
-        QString("DependencyInfo: %1").arg(dep.addonId.toString().isEmpty() ? dep.version : dep.addonId.toString()));
-
-    if (!dep.addonId.toString().isEmpty()) {
-        tasks->addTask(getProjectInfoTask(pDep));
-    }
+    auto dep = pDep->dependency;
+    auto provider = pDep->pack->provider == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
 
     ResourceAPI::DependencySearchArgs args = { dep, m_version, m_loaderType };
     ResourceAPI::DependencySearchCallbacks callbacks;
@@ -210,12 +278,12 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
                     auto over = std::find_if(overide.cbegin(), overide.cend(),
                                              [dep, provider](auto o) { return o.provider == provider.name && dep.addonId == o.quilt; });
                     if (over != overide.cend()) {
-                        removePack(dep.addonId);
-                        addTask(prepareDependencyTask({ over->fabric, dep.type }, provider.name, level));
+                        removePack(pDep);
+                        queueDependency({ over->fabric, dep.type }, provider.name, level);
                         return;
                     }
                 }
-                removePack(dep.addonId);
+                removePack(pDep);
                 qWarning() << "Error while reading mod version empty ";
                 qDebug() << doc;
                 return;
@@ -225,13 +293,13 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
             pDep->pack->versionsLoaded = true;
 
         } catch (const JSONValidationError& e) {
-            removePack(dep.addonId);
+            removePack(pDep);
             qDebug() << doc;
             qWarning() << "Error while reading mod version: " << e.cause();
             return;
         }
         if (level == 0) {
-            removePack(dep.addonId);
+            removePack(pDep);
             qWarning() << "Dependency cycle exceeded";
             return;
         }
@@ -239,119 +307,92 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
             pDep->pack->addonId = pDep->version.addonId;
             auto dep_ = getOverride({ pDep->version.addonId, pDep->dependency.type }, provider.name);
             if (dep_.addonId != pDep->version.addonId) {
-                removePack(pDep->version.addonId);
-                addTask(prepareDependencyTask(dep_, provider.name, level));
-            } else {
-                addTask(getProjectInfoTask(pDep));
+                removePack(pDep);
+                queueDependency(dep_, provider.name, level);
+                return;
             }
         }
         if (isLocalyInstalled(pDep)) {
-            removePack(pDep->version.addonId);
+            removePack(pDep);
             return;
         }
+        indexPack(pDep);
         for (auto dep_ : getDependenciesForVersion(pDep->version, provider.name)) {
-            addTask(prepareDependencyTask(dep_, provider.name, level - 1));
+            queueDependency(dep_, provider.name, level - 1);
         }
     };
 
-    auto version = provider.api->getDependencyVersion(std::move(args), std::move(callbacks));
-    tasks->addTask(version);
-    return tasks;
+    return provider.api->getDependencyVersion(std::move(args), std::move(callbacks));
+}
+
+void GetModDependenciesTask::indexPack(std::shared_ptr<PackDependency> pDep)
+{
+    auto provider = pDep->pack->provider;
+    if (!pDep->pack->addonId.toString().isEmpty())
+        m_pack_ids.insert(projectKey(provider, pDep->pack->addonId), pDep);
+    if (!pDep->dependency.version.isEmpty())
+        m_pack_ids.insert(fileKey(provider, pDep->dependency.version), pDep);
+    if (!pDep->version.fileId.toString().isEmpty())
+        m_pack_ids.insert(fileKey(provider, pDep->version.fileId), pDep);
+    if (!pDep->version.fileName.isEmpty())
+        m_pack_files.insert(StringUtils::laxName(pDep->version.fileName), pDep);
 }
 
-void GetModDependenciesTask::removePack(const QVariant& addonId)
+void GetModDependenciesTask::removePack(std::shared_ptr<PackDependency> pDep)
 {
-    auto pred = [addonId](const std::shared_ptr<PackDependency>& v) { return v->pack->addonId == addonId; };
-#if QT_VERSION >= QT_VERSION_CHECK(6, 1, 0)
-    m_pack_dependencies.removeIf(pred);
-#else
-    for (auto it = m_pack_dependencies.begin(); it != m_pack_dependencies.end();)
-        if (pred(*it))
-            it = m_pack_dependencies.erase(it);
+    m_pack_dependencies.removeOne(pDep);
+    for (auto it = m_pack_ids.begin(); it != m_pack_ids.end();)
+        if (it.value() == pDep)
+            it = m_pack_ids.erase(it);
         else
             ++it;
-#endif
+    if (auto fileName = StringUtils::laxName(pDep->version.fileName); m_pack_files.value(fileName) == pDep)
+        m_pack_files.remove(fileName);
 }
 
 auto GetModDependenciesTask::getExtraInfo() -> QHash<QString, PackDependencyExtraInfo>
 {
-    QHash<QString, PackDependencyExtraInfo> rby;
     auto fullList = m_selected + m_pack_dependencies;
-    for (auto& mod : fullList) {
-        auto addonId = mod->pack->addonId;
-        auto provider = mod->pack->provider;
-        auto version = mod->version.fileId;
-        auto req = QStringList();
-        for (auto& smod : fullList) {
-            if (provider != smod->pack->provider)
+
+    // names of the mods requiring each dependency, keyed the way the dependency refers to it
+    QHash<QString, QStringList> requiredBy;
+    for (auto& smod : fullList) {
+        auto provider = smod->pack->provider;
+        QSet<QString> keys;
+        for (auto& d : smod->version.dependencies) {
+            if (d.type != ModPlatform::DependencyType::REQUIRED)
                 continue;
-            auto deps = smod->version.dependencies;
-            if (auto dep = std::find_if(deps.begin(), deps.end(),
-                                        [addonId, provider, version](const ModPlatform::Dependency& d) {
-                                            return d.type == ModPlatform::DependencyType::REQUIRED &&
-                                                   (provider == ModPlatform::ResourceProvider::MODRINTH && d.addonId.toString().isEmpty()
-                                                        ? version == d.version
-                                                        : d.addonId == addonId);
-                                        });
-                dep != deps.end()) {
-                req.append(smod->pack->name);
-            }
+            auto isOnlyVersion = provider == ModPlatform::ResourceProvider::MODRINTH && d.addonId.toString().isEmpty();
+            keys.insert(isOnlyVersion ? fileKey(provider, d.version) : projectKey(provider, d.addonId));
+        }
+        for (auto& key : keys) {
+            requiredBy[key].append(smod->pack->name);
         }
-        rby[addonId.toString()] = { maybeInstalled(mod), req };
     }
-    return rby;
-}
 
-// super lax compare (but not fuzzy)
-// convert to lowercase
-// convert all speratores to whitespace
-// simplify sequence of internal whitespace to a single space
-// efectivly compare two strings ignoring all separators and case
-auto laxCompare = [](QString fsfilename, QString metadataFilename, bool excludeDigits = false) {
-    // allowed character seperators
-    QList<QChar> allowedSeperators = { '-', '+', '.', '_' };
-    if (excludeDigits)
-        allowedSeperators.append({ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9' });
-
-    // copy in lowercase
-    auto fsName = fsfilename.toLower();
-    auto metaName = metadataFilename.toLower();
-
-    // replace all potential allowed seperatores with whitespace
-    for (auto sep : allowedSeperators) {
-        fsName = fsName.replace(sep, ' ');
-        metaName = metaName.replace(sep, ' ');
+    QHash<QString, PackDependencyExtraInfo> rby;
+    for (auto& mod : fullList) {
+        auto provider = mod->pack->provider;
+        auto req = requiredBy.value(projectKey(provider, mod->pack->addonId));
+        if (provider == ModPlatform::ResourceProvider::MODRINTH)
+            req += requiredBy.value(fileKey(provider, mod->version.fileId));
+        rby[mod->pack->addonId.toString()] = { maybeInstalled(mod), req };
     }
-
-    // remove extraneous whitespace
-    fsName = fsName.simplified();
-    metaName = metaName.simplified();
-
-    return fsName.compare(metaName) == 0;
-};
+    return rby;
+}
 
 bool GetModDependenciesTask::isLocalyInstalled(std::shared_ptr<PackDependency> pDep)
 {
-    return pDep->version.fileName.isEmpty() ||
-
-           std::find_if(m_selected.begin(), m_selected.end(),
-                        [pDep](std::shared_ptr<PackDependency> i) {
-                            return !i->version.fileName.isEmpty() && laxCompare(i->version.fileName, pDep->version.fileName);
-                        }) != m_selected.end() ||  // check the selected versions
-
-           std::find_if(m_mods_file_names.begin(), m_mods_file_names.end(),
-                        [pDep](QString i) { return !i.isEmpty() && laxCompare(i, pDep->version.fileName); }) !=
-               m_mods_file_names.end() ||  // check the existing mods
-
-           std::find_if(m_pack_dependencies.begin(), m_pack_dependencies.end(), [pDep](std::shared_ptr<PackDependency> i) {
-               return pDep->pack->addonId != i->pack->addonId && !i->version.fileName.isEmpty() &&
-                      laxCompare(pDep->version.fileName, i->version.fileName);
-           }) != m_pack_dependencies.end();  // check loaded dependencies
+    if (pDep->version.fileName.isEmpty())
+        return true;
+    auto fileName = StringUtils::laxName(pDep->version.fileName);
+    if (m_installed_files.contains(fileName))
+        return true;  // check the selected versions and the existing mods
+    auto other = m_pack_files.value(fileName);
+    return other && other->pack->addonId != pDep->pack->addonId;  // check loaded dependencies
 }
 
 bool GetModDependenciesTask::maybeInstalled(std::shared_ptr<PackDependency> pDep)
 {
-    return std::find_if(m_mods_file_names.begin(), m_mods_file_names.end(), [pDep](QString i) {
-               return !i.isEmpty() && laxCompare(i, pDep->version.fileName, true);
-           }) != m_mods_file_names.end();  // check the existing mods
+    return !pDep->version.fileName.isEmpty() && m_installed_files_lax.contains(StringUtils::laxName(pDep->version.fileName, true));
 }
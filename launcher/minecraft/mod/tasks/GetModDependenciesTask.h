@@ -20,7 +20,9 @@
 
 #include <QDir>
 #include <QEventLoop>
+#include <QHash>
 #include <QList>
+#include <QSet>
 #include <QVariant>
 #include <functional>
 #include <memory>
@@ -61,28 +63,45 @@ class GetModDependenciesTask : public SequentialTask {
         std::shared_ptr<ResourceAPI> api;
     };
 
+    struct PendingDependency {
+        std::shared_ptr<PackDependency> pack_dep;
+        int level;
+    };
+
     explicit GetModDependenciesTask(BaseInstance* instance, ModFolderModel* folder, QList<std::shared_ptr<PackDependency>> selected);
 
     auto getDependecies() const -> QList<std::shared_ptr<PackDependency>> { return m_pack_dependencies; }
     QHash<QString, PackDependencyExtraInfo> getExtraInfo();
 
    protected slots:
-    Task::Ptr prepareDependencyTask(const ModPlatform::Dependency&, ModPlatform::ResourceProvider, int);
+    void queueDependency(const ModPlatform::Dependency&, ModPlatform::ResourceProvider, int);
+    void addNextLevel();
+    Task::Ptr getVersionTask(std::shared_ptr<PackDependency> pDep, int level);
     QList<ModPlatform::Dependency> getDependenciesForVersion(const ModPlatform::IndexedVersion&,
                                                              ModPlatform::ResourceProvider providerName);
     void prepare();
-    Task::Ptr getProjectInfoTask(std::shared_ptr<PackDependency> pDep);
+    Task::Ptr getProjectsInfoTask(const Provider& provider, QList<std::shared_ptr<PackDependency>> pDeps);
     ModPlatform::Dependency getOverride(const ModPlatform::Dependency&, ModPlatform::ResourceProvider providerName);
-    void removePack(const QVariant& addonId);
+    void indexPack(std::shared_ptr<PackDependency> pDep);
+    void removePack(std::shared_ptr<PackDependency> pDep);
 
     bool isLocalyInstalled(std::shared_ptr<PackDependency> pDep);
     bool maybeInstalled(std::shared_ptr<PackDependency> pDep);
 
    private:
     QList<std::shared_ptr<PackDependency>> m_pack_dependencies;
-    QList<std::shared_ptr<Metadata::ModStruct>> m_mods;
     QList<std::shared_ptr<PackDependency>> m_selected;
-    QStringList m_mods_file_names;
+    QList<PendingDependency> m_pending;
+
+    // project and file ids of the selected and installed mods, see projectKey and fileKey
+    QSet<QString> m_installed;
+    QHash<QString, std::shared_ptr<PackDependency>> m_pack_ids;
+    // file names normalized with laxName
+    QSet<QString> m_installed_files;
+    QSet<QString> m_installed_files_lax;
+    QHash<QString, std::shared_ptr<PackDependency>> m_pack_files;
+
+    int m_request_count = 0;
     Provider m_flame_provider;
     Provider m_modrinth_provider;
 
@@ -20,6 +20,7 @@
 
 #include "FileSystem.h"
 #include "Json.h"
+#include "minecraft/mod/PackThumbnail.h"
 
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
@@ -153,6 +154,12 @@ bool processZIP(ResourcePack& pack, ProcessingLevel level)
         return true;  // the png is optional
     };
 
+    if (auto thumbnail = PackThumbnail::load(pack.fileinfo()); !thumbnail.isNull()) {
+        pack.setImage(thumbnail);
+        zip.close();
+        return true;
+    }
+
     if (zip.setCurrentFile("pack.png")) {
         if (!file.open(QIODevice::ReadOnly)) {
             qCritical() << "Failed to open file in zip.";
@@ -280,9 +287,10 @@ bool processMCMeta(ResourcePack& pack, QByteArray&& raw_data)
 
 bool processPackPNG(const ResourcePack& pack, QByteArray&& raw_data)
 {
-    auto img = QImage::fromData(raw_data);
+    auto img = PackThumbnail::decode(raw_data);
     if (!img.isNull()) {
         pack.setImage(img);
+        PackThumbnail::store(pack.fileinfo(), img);
     } else {
         qWarning() << "Failed to parse pack.png.";
         return false;
@@ -319,6 +327,11 @@ bool processPackPNG(const ResourcePack& pack)
             return false;  // not processed correctly; https://github.com/PrismLauncher/PrismLauncher/issues/1740
         }
         case ResourceType::ZIPFILE: {
+            if (auto thumbnail = PackThumbnail::load(pack.fileinfo()); !thumbnail.isNull()) {
+                pack.setImage(thumbnail);
+                return true;
+            }
+
             QuaZip zip(pack.fileinfo().filePath());
             if (!zip.open(QuaZip::mdUnzip))
                 return false;  // can't open zip file
@@ -20,6 +20,7 @@
 #include "LocalTexturePackParseTask.h"
 
 #include "FileSystem.h"
+#include "minecraft/mod/PackThumbnail.h"
 
 #include <quazip/quazip.h>
 #include <quazip/quazipfile.h>
@@ -119,6 +120,12 @@ bool processZIP(TexturePack& pack, ProcessingLevel level)
         return true;
     }
 
+    if (auto thumbnail = PackThumbnail::load(pack.fileinfo()); !thumbnail.isNull()) {
+        pack.setImage(thumbnail);
+        zip.close();
+        return true;
+    }
+
     if (zip.setCurrentFile("pack.png")) {
         if (!file.open(QIODevice::ReadOnly)) {
             qCritical() << "Failed to open file in zip.";
@@ -150,9 +157,10 @@ bool processPackTXT(TexturePack& pack, QByteArray&& raw_data)
 
 bool processPackPNG(const TexturePack& pack, QByteArray&& raw_data)
 {
-    auto img = QImage::fromData(raw_data);
+    auto img = PackThumbnail::decode(raw_data);
     if (!img.isNull()) {
         pack.setImage(img);
+        PackThumbnail::store(pack.fileinfo(), img);
     } else {
         qWarning() << "Failed to parse pack.png.";
         return false;
@@ -189,6 +197,11 @@ bool processPackPNG(const TexturePack& pack)
             return false;
         }
         case ResourceType::ZIPFILE: {
+            if (auto thumbnail = PackThumbnail::load(pack.fileinfo()); !thumbnail.isNull()) {
+                pack.setImage(thumbnail);
+                return true;
+            }
+
             QuaZip zip(pack.fileinfo().filePath());
             if (!zip.open(QuaZip::mdUnzip))
                 return false;  // can't open zip file
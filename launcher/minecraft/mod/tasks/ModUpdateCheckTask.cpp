@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ModUpdateCheckTask.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "minecraft/MinecraftInstance.h"
+#include "minecraft/PackProfile.h"
+#include "minecraft/mod/ModFolderModel.h"
+#include "modplatform/flame/FlameCheckUpdate.h"
+#include "modplatform/modrinth/ModrinthCheckUpdate.h"
+#include "tasks/SequentialTask.h"
+
+ModUpdateCheckTask::ModUpdateCheckTask(MinecraftInstance* instance) : m_instance(instance), m_load_folder(true) {}
+
+ModUpdateCheckTask::ModUpdateCheckTask(MinecraftInstance* instance, std::shared_ptr<ModFolderModel> mods, QList<Mod*> candidates)
+    : m_instance(instance), m_mods_folder(mods), m_candidates(candidates), m_load_folder(false)
+{}
+
+void ModUpdateCheckTask::executeTask()
+{
+    if (!m_load_folder) {
+        checkMods();
+        return;
+    }
+    setStatus(tr("Loading mods"));
+    m_mods_folder = m_instance->loaderModList();
+    connect(m_mods_folder.get(), &ModFolderModel::updateFinished, this, &ModUpdateCheckTask::checkMods);
+    m_mods_folder->update();
+}
+
+void ModUpdateCheckTask::checkMods()
+{
+    if (m_load_folder) {
+        disconnect(m_mods_folder.get(), &ModFolderModel::updateFinished, this, &ModUpdateCheckTask::checkMods);
+        m_candidates = m_mods_folder->allMods();
+    }
+    if (!isRunning())
+        return;
+
+    for (auto mod : m_candidates) {
+        if (auto meta = mod->metadata(); meta) {
+            (meta->provider == ModPlatform::ResourceProvider::MODRINTH ? m_modrinth_mods : m_flame_mods).append(mod);
+        } else if (mod->type() != ResourceType::FOLDER) {
+            m_skipped.append(mod->fileinfo().fileName());
+        }
+    }
+
+    auto profile = m_instance->getPackProfile();
+    auto minecraft = profile->getComponent("net.minecraft");
+    if (!minecraft) {
+        emitFailed(tr("The instance has no Minecraft version"));
+        return;
+    }
+    m_versions = { minecraft->getVersion() };
+    auto loaders = profile->getModLoadersList();
+
+    auto check = makeShared<SequentialTask>(tr("Checking for updates"));
+    QList<shared_qobject_ptr<CheckUpdateTask>> checks;
+    if (!m_modrinth_mods.isEmpty())
+        checks.append(makeShared<ModrinthCheckUpdate>(m_modrinth_mods, m_versions, loaders, m_mods_folder));
+    if (!m_flame_mods.isEmpty())
+        checks.append(makeShared<FlameCheckUpdate>(m_flame_mods, m_versions, loaders, m_mods_folder));
+    for (auto task : checks) {
+        connect(task.get(), &CheckUpdateTask::checkFailed, this,
+                [this](Mod* mod, QString reason, QUrl recover_url) { m_failed.append({ mod, reason, recover_url }); });
+        connect(task.get(), &Task::succeeded, this, [this, task] {
+            auto updatable = task->getUpdatable();
+            std::move(updatable.begin(), updatable.end(), std::back_inserter(m_updatable));
+            m_dependencies.append(task->getDependencies());
+        });
+        check->addTask(task);
+    }
+
+    m_task = check;
+    connect(check.get(), &Task::succeeded, this, [this, check = check.get()] {
+        for (auto& warning : check->warnings())
+            logWarning(warning);
+        emitSucceeded();
+    });
+    connect(check.get(), &Task::failed, this, &ModUpdateCheckTask::emitFailed);
+    connect(check.get(), &Task::progress, this, &ModUpdateCheckTask::setProgress);
+    connect(check.get(), &Task::status, this, &ModUpdateCheckTask::setStatus);
+    connect(check.get(), &Task::stepProgress, this, &ModUpdateCheckTask::propagateStepProgress);
+    check->start();
+}
+
+bool ModUpdateCheckTask::abort()
+{
+    if (m_task)
+        m_task->abort();
+    emitAborted();
+    return true;
+}
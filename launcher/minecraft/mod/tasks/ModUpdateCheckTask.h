@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QStringList>
+#include <QUrl>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "Version.h"
+#include "minecraft/mod/tasks/GetModDependenciesTask.h"
+#include "modplatform/CheckUpdateTask.h"
+#include "tasks/Task.h"
+
+class MinecraftInstance;
+class ModFolderModel;
+
+/** Checks mods that have metadata for updates, nothing is asked or installed.
+ *  Without candidates, it loads the mod folder of the instance and checks all of its mods. Mods without metadata are skipped then,
+ *  generating it needs the user to pick a provider.
+ */
+class ModUpdateCheckTask : public Task {
+    Q_OBJECT
+   public:
+    struct FailedCheck {
+        Mod* mod;
+        QString reason;
+        QUrl recover_url;
+    };
+
+    explicit ModUpdateCheckTask(MinecraftInstance* instance);
+    ModUpdateCheckTask(MinecraftInstance* instance, std::shared_ptr<ModFolderModel> mods, QList<Mod*> candidates);
+    ~ModUpdateCheckTask() override = default;
+
+    bool canAbort() const override { return true; }
+
+    const std::vector<CheckUpdateTask::UpdatableMod>& getUpdatable() const { return m_updatable; }
+    const QList<std::shared_ptr<GetModDependenciesTask::PackDependency>>& getDependencies() const { return m_dependencies; }
+    QStringList getSkipped() const { return m_skipped; }
+    const QList<FailedCheck>& getFailed() const { return m_failed; }
+
+   public slots:
+    bool abort() override;
+
+   protected:
+    void executeTask() override;
+
+   private slots:
+    void checkMods();
+
+   private:
+    MinecraftInstance* m_instance;
+    std::shared_ptr<ModFolderModel> m_mods_folder;
+    QList<Mod*> m_candidates;
+    bool m_load_folder;
+    Task::Ptr m_task;
+
+    // the check tasks keep references to these
+    QList<Mod*> m_modrinth_mods;
+    QList<Mod*> m_flame_mods;
+    std::list<Version> m_versions;
+
+    std::vector<CheckUpdateTask::UpdatableMod> m_updatable;
+    QList<std::shared_ptr<GetModDependenciesTask::PackDependency>> m_dependencies;
+    QStringList m_skipped;
+    QList<FailedCheck> m_failed;
+};
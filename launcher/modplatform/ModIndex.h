@@ -101,6 +101,7 @@ struct IndexedVersion {
     QString downloadUrl;
     QString date;
     QString fileName;
+    qint64 size = -1;
     ModLoaderTypes loaders = {};
     QString hash_type;
     QString hash;
@@ -813,6 +813,7 @@ void PackInstallTask::downloadMods()
             blocked_mod.name = mod.file;
             blocked_mod.websiteUrl = mod.url;
             blocked_mod.hash = mod.md5;
+            blocked_mod.size = mod.filesize;
             blocked_mod.matched = false;
             blocked_mod.localPath = "";
 
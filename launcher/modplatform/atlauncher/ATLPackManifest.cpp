@@ -142,6 +142,7 @@ static void loadVersionMod(ATLauncher::VersionMod& p, QJsonObject& obj)
     p.url = Json::requireString(obj, "url");
     p.file = Json::requireString(obj, "file");
     p.md5 = Json::ensureString(obj, "md5", "");
+    p.filesize = static_cast<qint64>(Json::ensureDouble(obj, "filesize", -1));
 
     p.download_raw = Json::requireString(obj, "download");
     p.download = parseDownloadType(p.download_raw);
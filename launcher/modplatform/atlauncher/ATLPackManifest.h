@@ -93,6 +93,7 @@ struct VersionMod {
     QString url;
     QString file;
     QString md5;
+    qint64 filesize;
     DownloadType download;
     QString download_raw;
     ModType type;
@@ -55,6 +55,7 @@
 #include "settings/INISettingsObject.h"
 
 #include "tasks/ConcurrentTask.h"
+#include "tasks/TaskGraph.h"
 #include "ui/dialogs/BlockedModsDialog.h"
 #include "ui/dialogs/CustomMessageBox.h"
 
@@ -165,16 +166,23 @@ bool FlameCreationTask::updateInstance()
 
         QDir old_minecraft_dir(inst->gameRoot());
 
-        // We will remove all the previous overrides, to prevent duplicate files!
-        // TODO: Currently 'overrides' will always override the stuff on update. How do we preserve unchanged overrides?
+        // Only touch the overrides that actually changed, the unchanged ones are left alone
         // FIXME: We may want to do something about disabled mods.
-        auto old_overrides = Override::readOverrides("overrides", old_index_folder);
-        for (const auto& entry : old_overrides) {
-            if (entry.isEmpty())
-                continue;
+        setStatus(tr("Comparing overrides with the installed instance..."));
+        auto installed_root = old_minecraft_dir.absolutePath();
+        Override::Layer overrides{ Override::readOverrides("overrides", old_index_folder),
+                                   FS::PathCombine(m_stagingPath, m_pack.overrides) };
+        m_overrides_delta = Override::diffOverridesInBackground({ overrides }, installed_root).first();
+        for (const auto& entry : m_overrides_delta.removed) {
             qDebug() << "Scheduling" << entry << "for removal";
             m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(entry));
         }
+        // the manifest doesn't have the file sizes, those are only known once the download urls are resolved,
+        // so there is no total size to show that wouldn't leave out most of the update
+        qDebug() << "Update plan:" << files.size() << "files to download," << m_overrides_delta.changed.size() << "overrides to write,"
+                 << m_overrides_delta.unchanged.size() << "overrides unchanged";
+        setDetails(tr("%1 files to download, %2 overrides to write")
+                       .arg(QString::number(files.size()), QString::number(m_overrides_delta.changed.size())));
 
         // Remove remaining old files (we need to do an API request to know which ids are which files...)
         QStringList fileIds;
@@ -336,6 +344,7 @@ bool FlameCreationTask::createInstance()
         if (QFile::exists(overridePath)) {
             // Create a list of overrides in "overrides.txt" inside flame/
             Override::createOverrides("overrides", parent_folder, overridePath);
+            Override::dropUnchanged(m_overrides_delta, overridePath, m_files_to_remove);
 
             QString mcPath = FS::PathCombine(m_stagingPath, "minecraft");
             if (!FS::move(overridePath, mcPath)) {
@@ -486,6 +495,7 @@ void FlameCreationTask::idResolverSucceeded(QEventLoop& loop)
             blocked_mod.matched = false;
             blocked_mod.localPath = "";
             blocked_mod.targetFolder = result.targetFolder;
+            blocked_mod.size = result.version.size;
 
             blocked_mods.append(blocked_mod);
 
@@ -558,22 +568,38 @@ void FlameCreationTask::setupDownloadJob(QEventLoop& loop)
         }
     }
 
-    connect(m_files_job.get(), &NetJob::finished, this, [this, &loop]() {
-        m_files_job.reset();
-        validateZIPResources(loop);
-    });
-    connect(m_files_job.get(), &NetJob::failed, [&](QString reason) {
-        m_files_job.reset();
-        setError(reason);
-    });
+    auto folder = FS::PathCombine(m_stagingPath, "minecraft", "mods", ".index");
+    auto concurrency = APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt();
+
+    // The metadata of regular mods only needs the API results, so it is written while the files download.
+    // Resources shipped as .zip have to be downloaded and identified first, as they may not be mods at all.
+    auto metadataTask = makeShared<ConcurrentTask>("CreateModMetadata", concurrency);
+    for (const auto& file : results) {
+        if (file.targetFolder != "mods" || file.version.fileName.endsWith(".zip"))
+            continue;
+        metadataTask->addTask(makeShared<LocalModUpdateTask>(folder, file.pack, file.version));
+    }
+    auto zipMetadataTask = makeShared<ConcurrentTask>("CreateZIPModMetadata", concurrency);
+
+    auto installGraph = makeShared<TaskGraph>(tr("Flame pack installation"), 3);
+    installGraph->addTask(m_files_job);
+    installGraph->addOptionalTask(metadataTask);
+    installGraph->addOptionalTask(zipMetadataTask, { m_files_job });
+
+    // connected before the graph starts the download, so the ZIP metadata tasks exist by the time their node runs
+    connect(m_files_job.get(), &NetJob::succeeded, this, [this, zipMetadataTask]() { validateZIPResources(zipMetadataTask); });
+    connect(m_files_job.get(), &NetJob::finished, this, [this]() { m_files_job.reset(); });
+    connect(m_files_job.get(), &NetJob::failed, this, [this](QString reason) { setError(reason); });
     connect(m_files_job.get(), &NetJob::progress, this, [this](qint64 current, qint64 total) {
         setDetails(tr("%1 out of %2 complete").arg(current).arg(total));
         setProgress(current, total);
     });
     connect(m_files_job.get(), &NetJob::stepProgress, this, &FlameCreationTask::propagateStepProgress);
+    connect(installGraph.get(), &Task::finished, &loop, &QEventLoop::quit);
 
     setStatus(tr("Downloading mods..."));
-    m_files_job->start();
+    m_process_update_file_info_job = installGraph;
+    installGraph->start();
 }
 
 /// @brief copy the matched blocked mods to the instance staging area
@@ -608,7 +634,7 @@ void FlameCreationTask::copyBlockedMods(QList<BlockedMod> const& blocked_mods)
     setAbortable(true);
 }
 
-void FlameCreationTask::validateZIPResources(QEventLoop& loop)
+void FlameCreationTask::validateZIPResources(ConcurrentTask::Ptr zipMetadataTask)
 {
     qDebug() << "Validating whether resources stored as .zip are in the right place";
     QStringList zipMods;
@@ -677,16 +703,12 @@ void FlameCreationTask::validateZIPResources(QEventLoop& loop)
                 break;
         }
     }
-    auto task = makeShared<ConcurrentTask>("CreateModMetadata", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
     auto results = m_mod_id_resolver->getResults().files;
     auto folder = FS::PathCombine(m_stagingPath, "minecraft", "mods", ".index");
     for (auto file : results) {
-        if (file.targetFolder != "mods" || (file.version.fileName.endsWith(".zip") && !zipMods.contains(file.version.fileName))) {
+        if (file.targetFolder != "mods" || !file.version.fileName.endsWith(".zip") || !zipMods.contains(file.version.fileName)) {
             continue;
         }
-        task->addTask(makeShared<LocalModUpdateTask>(folder, file.pack, file.version));
+        zipMetadataTask->addTask(makeShared<LocalModUpdateTask>(folder, file.pack, file.version));
     }
-    connect(task.get(), &Task::finished, &loop, &QEventLoop::quit);
-    m_process_update_file_info_job = task;
-    task->start();
 }
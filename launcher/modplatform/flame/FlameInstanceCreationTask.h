@@ -42,8 +42,10 @@
 #include "minecraft/MinecraftInstance.h"
 
 #include "modplatform/flame/FileResolvingTask.h"
+#include "modplatform/helpers/OverrideUtils.h"
 
 #include "net/NetJob.h"
+#include "tasks/ConcurrentTask.h"
 
 #include "ui/dialogs/BlockedModsDialog.h"
 
@@ -74,7 +76,7 @@ class FlameCreationTask final : public InstanceCreationTask {
     void idResolverSucceeded(QEventLoop&);
     void setupDownloadJob(QEventLoop&);
     void copyBlockedMods(QList<BlockedMod> const& blocked_mods);
-    void validateZIPResources(QEventLoop& loop);
+    void validateZIPResources(ConcurrentTask::Ptr zipMetadataTask);
     QString getVersionForLoader(QString uid, QString loaderType, QString version, QString mcVersion);
 
    private:
@@ -91,5 +93,7 @@ class FlameCreationTask final : public InstanceCreationTask {
 
     QList<std::pair<QString, QString>> m_ZIP_resources;
 
+    Override::Delta m_overrides_delta;
+
     std::optional<InstancePtr> m_instance;
 };
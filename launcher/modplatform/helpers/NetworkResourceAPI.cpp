@@ -3,15 +3,101 @@
 // SPDX-License-Identifier: GPL-3.0-only
 
 #include "NetworkResourceAPI.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
 #include <memory>
 
 #include "Application.h"
+#include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 
 #include "modplatform/ModIndex.h"
 
 #include "net/ApiDownload.h"
 
+namespace {
+// how long a response is used as-is before we ask the server about it again
+const qint64 SEARCH_MAX_AGE = 10 * 60;
+const qint64 VERSIONS_MAX_AGE = 10 * 60;
+const qint64 PROJECT_MAX_AGE = 60 * 60;
+// until then an older response is still shown right away, and revalidated in the background for next time
+const qint64 STALE_MAX_AGE = 24 * 60 * 60;
+// keeps the ETag around well past that, so refetching can still be a conditional request
+const qint64 ENTRY_MAX_AGE = 7 * 24 * 60 * 60;
+
+// the URLs are built from the request arguments alone, so they make a good key
+MetaEntryPtr cacheEntry(const QUrl& url)
+{
+    auto hash = QCryptographicHash::hash(url.toString(QUrl::FullyEncoded).toUtf8(), QCryptographicHash::Sha1).toHex();
+    return APPLICATION->metacache()->resolveEntry("api", url.host() + '/' + hash + ".json");
+}
+
+qint64 cacheAge(const MetaEntryPtr& entry)
+{
+    QFileInfo info(entry->getFullPath());
+    if (!info.isFile() || info.size() == 0)
+        return -1;
+    return info.lastModified().secsTo(QDateTime::currentDateTime());
+}
+
+void markRefreshed(const MetaEntryPtr& entry)
+{
+    // we fell back to the local copy after a network error
+    if (entry->isStale())
+        return;
+    // a 304 leaves the file untouched, so restart its clock ourselves
+    QFile file(entry->getFullPath());
+    if (file.open(QIODevice::ReadWrite))
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    file.close();
+    entry->setLocalChangedTimestamp(QFileInfo(file.fileName()).lastModified().toUTC().toMSecsSinceEpoch());
+    entry->setCurrentAge(0);
+    entry->setMaximumAge(ENTRY_MAX_AGE);
+    APPLICATION->metacache()->updateEntry(entry);
+}
+
+void revalidate(const QString& name, const QUrl& url, const MetaEntryPtr& entry)
+{
+    entry->setStale(true);
+    auto job = makeShared<NetJob>(name + "::Revalidate", APPLICATION->network());
+    job->addNetAction(Net::ApiDownload::makeCached(url, entry));
+    QObject::connect(job.get(), &NetJob::succeeded, [entry] { markRefreshed(entry); });
+    // nobody holds on to this one, so it keeps itself alive until it is done,
+    // and only lets go once control is back in the event loop, as the job is still emitting here
+    QObject::connect(job.get(), &NetJob::finished, job.get(), [job]() mutable { QTimer::singleShot(0, [job = std::move(job)] {}); });
+    job->start();
+}
+
+// Fetches url through the API response cache and puts the body into response before any other succeeded handler runs.
+NetJob::Ptr makeCachedJob(const QString& name, const QUrl& url, std::shared_ptr<QByteArray> response, qint64 maxAge)
+{
+    auto entry = cacheEntry(url);
+    auto age = cacheAge(entry);
+    bool useCached = age >= 0 && age < STALE_MAX_AGE;
+    // a non-stale entry is served straight from disk, a stale one becomes a conditional request
+    entry->setStale(!useCached);
+
+    auto netJob = makeShared<NetJob>(name, APPLICATION->network());
+    netJob->addNetAction(Net::ApiDownload::makeCached(url, entry, Net::Download::Option::AcceptLocalFiles));
+
+    QObject::connect(netJob.get(), &NetJob::succeeded, [name, url, entry, response, useCached, outdated = age >= maxAge] {
+        QFile file(entry->getFullPath());
+        if (file.open(QIODevice::ReadOnly))
+            *response = file.readAll();
+
+        if (!useCached)
+            markRefreshed(entry);
+        else if (outdated)
+            revalidate(name, url, entry);
+    });
+
+    return netJob;
+}
+}  // namespace
+
 Task::Ptr NetworkResourceAPI::searchProjects(SearchArgs&& args, SearchCallbacks&& callbacks) const
 {
     auto search_url_optional = getSearchURL(args);
@@ -23,9 +109,7 @@ Task::Ptr NetworkResourceAPI::searchProjects(SearchArgs&& args, SearchCallbacks&
     auto search_url = search_url_optional.value();
 
     auto response = std::make_shared<QByteArray>();
-    auto netJob = makeShared<NetJob>(QString("%1::Search").arg(debugName()), APPLICATION->network());
-
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(search_url), response));
+    auto netJob = makeCachedJob(QString("%1::Search").arg(debugName()), QUrl(search_url), response, SEARCH_MAX_AGE);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [this, response, callbacks] {
         QJsonParseError parse_error{};
@@ -90,10 +174,8 @@ Task::Ptr NetworkResourceAPI::getProjectVersions(VersionSearchArgs&& args, Versi
 
     auto versions_url = versions_url_optional.value();
 
-    auto netJob = makeShared<NetJob>(QString("%1::Versions").arg(args.pack.name), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
-
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(versions_url, response));
+    auto netJob = makeCachedJob(QString("%1::Versions").arg(args.pack.name), versions_url, response, VERSIONS_MAX_AGE);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [response, callbacks, args] {
         QJsonParseError parse_error{};
@@ -132,11 +214,7 @@ Task::Ptr NetworkResourceAPI::getProject(QString addonId, std::shared_ptr<QByteA
 
     auto project_url = project_url_optional.value();
 
-    auto netJob = makeShared<NetJob>(QString("%1::GetProject").arg(addonId), APPLICATION->network());
-
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(project_url), response));
-
-    return netJob;
+    return makeCachedJob(QString("%1::GetProject").arg(addonId), QUrl(project_url), response, PROJECT_MAX_AGE);
 }
 
 Task::Ptr NetworkResourceAPI::getDependencyVersion(DependencySearchArgs&& args, DependencySearchCallbacks&& callbacks) const
@@ -147,10 +225,9 @@ Task::Ptr NetworkResourceAPI::getDependencyVersion(DependencySearchArgs&& args,
 
     auto versions_url = versions_url_optional.value();
 
-    auto netJob = makeShared<NetJob>(QString("%1::Dependency").arg(args.dependency.addonId.toString()), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
-
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(versions_url, response));
+    auto netJob =
+        makeCachedJob(QString("%1::Dependency").arg(args.dependency.addonId.toString()), versions_url, response, VERSIONS_MAX_AGE);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [=] {
         QJsonParseError parse_error{};
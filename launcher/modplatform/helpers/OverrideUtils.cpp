@@ -1,8 +1,15 @@
 #include "OverrideUtils.h"
 
 #include <QDirIterator>
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QSet>
+#include <QtConcurrentRun>
+
+#include <algorithm>
 
 #include "FileSystem.h"
+#include "modplatform/helpers/HashUtils.h"
 
 namespace Override {
 
@@ -56,4 +63,96 @@ QStringList readOverrides(const QString& name, const QString& parent_folder)
     return previous_overrides;
 }
 
+static bool sameContent(const QFileInfo& a, const QFileInfo& b)
+{
+    if (!a.isFile() || !b.isFile() || a.size() != b.size())
+        return false;
+    return Hashing::hash(a.absoluteFilePath(), Hashing::Algorithm::Sha1) == Hashing::hash(b.absoluteFilePath(), Hashing::Algorithm::Sha1);
+}
+
+Delta diffOverrides(const QStringList& previous, const QString& override_path, const QString& installed_root)
+{
+    return diffOverrides(QList<Layer>{ { previous, override_path } }, installed_root).first();
+}
+
+QList<Delta> diffOverrides(const QList<Layer>& layers, const QString& installed_root)
+{
+    QDir installed_dir(installed_root);
+
+    QList<QStringList> entries;
+    QSet<QString> current;
+    for (const auto& layer : layers) {
+        QDir override_dir(layer.path);
+        QStringList files;
+        QDirIterator override_iterator(layer.path, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+        while (override_iterator.hasNext())
+            files.append(override_dir.relativeFilePath(override_iterator.next()));
+        current.unite(QSet<QString>(files.begin(), files.end()));
+        entries.append(files);
+    }
+
+    QList<Delta> deltas;
+    // the last layer that ships a file decides what gets installed
+    QSet<QString> later;
+    for (auto i = layers.size() - 1; i >= 0; i--) {
+        Delta delta;
+        delta.installedRoot = installed_root;
+        QDir override_dir(layers[i].path);
+        for (const auto& relative_path : entries[i]) {
+            if (later.contains(relative_path)) {
+                delta.shadowed.append(relative_path);
+                continue;
+            }
+
+            QFileInfo override_info(override_dir.absoluteFilePath(relative_path));
+            if (sameContent(override_info, QFileInfo(installed_dir.absoluteFilePath(relative_path)))) {
+                delta.unchanged.append(relative_path);
+            } else {
+                delta.changed.append(relative_path);
+                delta.bytesToWrite += override_info.size();
+            }
+        }
+        later.unite(QSet<QString>(entries[i].begin(), entries[i].end()));
+
+        for (const auto& entry : layers[i].previous) {
+            if (entry.isEmpty() || current.contains(entry))
+                continue;
+            delta.removed.append(entry);
+        }
+        deltas.prepend(delta);
+    }
+
+    return deltas;
+}
+
+QList<Delta> diffOverridesInBackground(const QList<Layer>& layers, const QString& installed_root)
+{
+    QEventLoop loop;
+    QFutureWatcher<QList<Delta>> watcher;
+    QObject::connect(&watcher, &QFutureWatcher<QList<Delta>>::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(
+        QtConcurrent::run(QThreadPool::globalInstance(), [layers, installed_root] { return diffOverrides(layers, installed_root); }));
+    if (!watcher.isFinished())
+        loop.exec();
+    return watcher.result();
+}
+
+void dropUnchanged(const Delta& delta, const QString& override_path, QStringList& files_to_remove)
+{
+    QDir override_dir(override_path);
+    QDir installed_dir(delta.installedRoot);
+    QSet<QString> kept;
+    for (const auto& entry : delta.unchanged) {
+        QFile::remove(override_dir.absoluteFilePath(entry));
+        kept.insert(QDir::cleanPath(installed_dir.absoluteFilePath(entry)));
+    }
+    // the layer that shadows these takes care of the installed file
+    for (const auto& entry : delta.shadowed)
+        QFile::remove(override_dir.absoluteFilePath(entry));
+    // the installed file is what the override would have written, deleting it would lose it for good
+    files_to_remove.erase(std::remove_if(files_to_remove.begin(), files_to_remove.end(),
+                                         [&kept](const QString& path) { return kept.contains(QDir::cleanPath(path)); }),
+                          files_to_remove.end());
+}
+
 }  // namespace Override
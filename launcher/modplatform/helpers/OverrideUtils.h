@@ -1,6 +1,8 @@
 #pragma once
 
+#include <QList>
 #include <QString>
+#include <QStringList>
 
 namespace Override {
 
@@ -17,4 +19,49 @@ void createOverrides(const QString& name, const QString& parent_folder, const QS
  */
 QStringList readOverrides(const QString& name, const QString& parent_folder);
 
+/** What applying a new set of overrides over an installed instance would change. */
+struct Delta {
+    // same content as the installed file, there's no need to write them again
+    QStringList unchanged;
+    // different from the installed file, or not installed at all
+    QStringList changed;
+    // previous overrides that are not part of the new set anymore
+    QStringList removed;
+    // also shipped by a later layer, which is what ends up installed, so these are never written
+    QStringList shadowed;
+    // bytes that will be written when applying the changed overrides
+    qint64 bytesToWrite = 0;
+    // the installed instance folder the overrides were compared with
+    QString installedRoot;
+};
+
+/** One folder of overrides, along with the list of what it held in the installed version. */
+struct Layer {
+    QStringList previous;
+    QString path;
+};
+
+/** Compares the overrides extracted at `override_path` with the files installed at `installed_root`,
+ *  and with the `previous` overrides list of the installed version.
+ *
+ *  Files are compared by size first, and by hash only when the sizes match.
+ */
+Delta diffOverrides(const QStringList& previous, const QString& override_path, const QString& installed_root);
+
+/** Same as diffOverrides(), for override folders that are applied one over the other, the later ones winning.
+ *
+ *  Only the file that ends up installed is compared, the ones it replaces are reported as shadowed.
+ *  A previous override is only removed when no layer ships it anymore.
+ */
+QList<Delta> diffOverrides(const QList<Layer>& layers, const QString& installed_root);
+
+/** Same as diffOverrides(), but hashes on a worker thread while the caller's event loop keeps running. */
+QList<Delta> diffOverridesInBackground(const QList<Layer>& layers, const QString& installed_root);
+
+/** Removes the unchanged and shadowed overrides from `override_path`, so they are not copied over the installed instance.
+ *
+ *  As the installed files are kept instead of the unchanged ones, those are also taken out of `files_to_remove`.
+ */
+void dropUnchanged(const Delta& delta, const QString& override_path, QStringList& files_to_remove);
+
 }  // namespace Override
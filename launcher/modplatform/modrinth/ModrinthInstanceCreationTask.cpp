@@ -6,6 +6,7 @@
 #include "Json.h"
 
 #include "QObjectPtr.h"
+#include "StringUtils.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
 
@@ -19,6 +20,7 @@
 #include "net/ApiDownload.h"
 #include "net/NetJob.h"
 #include "settings/INISettingsObject.h"
+#include "tasks/TaskGraph.h"
 
 #include "ui/dialogs/CustomMessageBox.h"
 #include "ui/pages/modplatform/OptionalModDialog.h"
@@ -26,6 +28,7 @@
 #include <QAbstractButton>
 #include <QFileInfo>
 #include <QHash>
+#include <optional>
 #include <vector>
 
 bool ModrinthCreationTask::abort()
@@ -88,60 +91,85 @@ bool ModrinthCreationTask::updateInstance()
         std::vector<Modrinth::File> old_files;
         parseManifest(old_index_path, old_files, false, false);
 
+        QDir old_minecraft_dir(inst->gameRoot());
+
         // Let's remove all duplicated, identical resources!
-        auto files_iterator = m_files.begin();
-    begin:
-        while (files_iterator != m_files.end()) {
-            auto const& file = *files_iterator;
-
-            auto old_files_iterator = old_files.begin();
-            while (old_files_iterator != old_files.end()) {
-                auto const& old_file = *old_files_iterator;
-
-                if (old_file.hash == file.hash) {
-                    qDebug() << "Removed file at" << file.path << "from list of downloads";
-                    files_iterator = m_files.erase(files_iterator);
-                    old_files_iterator = old_files.erase(old_files_iterator);
-                    goto begin;  // Sorry :c
+        QMultiHash<QByteArray, Modrinth::File> old_by_hash;
+        for (auto const& old_file : old_files)
+            old_by_hash.insert(old_file.hash, old_file);
+
+        auto take_old_file = [&old_by_hash](const Modrinth::File& file, bool same_path) -> std::optional<Modrinth::File> {
+            for (auto it = old_by_hash.find(file.hash); it != old_by_hash.end() && it.key() == file.hash; it++) {
+                if (!same_path || it->path == file.path) {
+                    auto old_file = *it;
+                    old_by_hash.erase(it);
+                    return old_file;
                 }
-
-                old_files_iterator++;
             }
-
-            files_iterator++;
+            return {};
+        };
+
+        // Identical files at the same place don't need to be touched at all
+        std::vector<Modrinth::File> changed_files;
+        for (auto const& file : m_files) {
+            if (take_old_file(file, true)) {
+                qDebug() << "Removed file at" << file.path << "from list of downloads";
+                continue;
+            }
+            changed_files.push_back(file);
         }
 
-        QDir old_minecraft_dir(inst->gameRoot());
-
-        // Some files were removed from the old version, and some will be downloaded in an updated version,
-        // so we're fine removing them!
-        if (!old_files.empty()) {
-            for (auto const& file : old_files) {
-                if (file.path.isEmpty())
+        // Identical files that only moved are copied from the installed instance instead of being downloaded
+        qint64 bytes_to_download = 0;
+        m_files.clear();
+        for (auto const& file : changed_files) {
+            if (auto old_file = take_old_file(file, false)) {
+                auto old_path = old_minecraft_dir.absoluteFilePath(old_file->path);
+                if (QFileInfo::exists(old_path)) {
+                    qDebug() << "File at" << file.path << "was moved from" << old_file->path << ", copying it locally";
+                    m_local_copies.append({ old_path, file.path });
+                    // the old location is not part of the pack anymore
+                    m_files_to_remove.append(old_path);
                     continue;
-                qDebug() << "Scheduling" << file.path << "for removal";
-                m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(file.path));
+                }
             }
+            bytes_to_download += file.fileSize;
+            m_files.push_back(file);
         }
 
-        // We will remove all the previous overrides, to prevent duplicate files!
-        // TODO: Currently 'overrides' will always override the stuff on update. How do we preserve unchanged overrides?
-        // FIXME: We may want to do something about disabled mods.
-        auto old_overrides = Override::readOverrides("overrides", old_index_folder);
-        for (const auto& entry : old_overrides) {
-            if (entry.isEmpty())
+        // Some files were removed from the old version, and some will be downloaded in an updated version,
+        // so we're fine removing them!
+        for (auto const& file : old_by_hash) {
+            if (file.path.isEmpty())
                 continue;
-            qDebug() << "Scheduling" << entry << "for removal";
-            m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(entry));
+            qDebug() << "Scheduling" << file.path << "for removal";
+            m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(file.path));
         }
 
-        auto old_client_overrides = Override::readOverrides("client-overrides", old_index_folder);
-        for (const auto& entry : old_client_overrides) {
-            if (entry.isEmpty())
-                continue;
+        // Only touch the overrides that actually changed, the unchanged ones are left alone
+        // FIXME: We may want to do something about disabled mods.
+        setStatus(tr("Comparing overrides with the installed instance..."));
+        auto installed_root = old_minecraft_dir.absolutePath();
+        // client overrides are applied over the regular ones, so they are compared as one merged tree
+        auto deltas = Override::diffOverridesInBackground(
+            { { Override::readOverrides("overrides", old_index_folder), FS::PathCombine(m_stagingPath, "overrides") },
+              { Override::readOverrides("client-overrides", old_index_folder), FS::PathCombine(m_stagingPath, "client-overrides") } },
+            installed_root);
+        m_overrides_delta = deltas.at(0);
+        m_client_overrides_delta = deltas.at(1);
+        for (const auto& entry : m_overrides_delta.removed + m_client_overrides_delta.removed) {
             qDebug() << "Scheduling" << entry << "for removal";
             m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(entry));
         }
+
+        auto override_bytes = m_overrides_delta.bytesToWrite + m_client_overrides_delta.bytesToWrite;
+        auto override_count = m_overrides_delta.changed.size() + m_client_overrides_delta.changed.size();
+        qDebug() << "Update plan:" << m_files.size() << "files to download" << "(" << bytes_to_download << "bytes),"
+                 << m_local_copies.size() << "files to copy locally," << override_count << "overrides to write (" << override_bytes
+                 << "bytes)," << m_files_to_remove.size() << "files to remove";
+        setDetails(tr("%1 to download, %2 of overrides to write, %3 files to remove")
+                       .arg(StringUtils::humanReadableFileSize(bytes_to_download, true),
+                            StringUtils::humanReadableFileSize(override_bytes, true), QString::number(m_files_to_remove.size())));
     } else {
         // We don't have an old index file, so we may duplicate stuff!
         auto dialog = CustomMessageBox::selectable(m_parent, tr("No index file."),
@@ -186,6 +214,7 @@ bool ModrinthCreationTask::createInstance()
     if (QFile::exists(override_path)) {
         // Create a list of overrides in "overrides.txt" inside mrpack/
         Override::createOverrides("overrides", parent_folder, override_path);
+        Override::dropUnchanged(m_overrides_delta, override_path, m_files_to_remove);
 
         // Apply the overrides
         if (!FS::move(override_path, mcPath)) {
@@ -199,6 +228,7 @@ bool ModrinthCreationTask::createInstance()
     if (QFile::exists(client_override_path)) {
         // Create a list of overrides in "client-overrides.txt" inside mrpack/
         Override::createOverrides("client-overrides", parent_folder, client_override_path);
+        Override::dropUnchanged(m_client_overrides_delta, client_override_path, m_files_to_remove);
 
         // Apply the overrides
         if (!FS::overrideFolder(mcPath, client_override_path)) {
@@ -207,6 +237,16 @@ bool ModrinthCreationTask::createInstance()
         }
     }
 
+    // Files that only moved inside the pack are copied from the installed instance instead of being downloaded again
+    for (auto const& [old_path, new_path] : m_local_copies) {
+        auto target = FS::PathCombine(mcPath, new_path);
+        FS::ensureFilePathExists(target);
+        if (!QFile::copy(old_path, target)) {
+            setError(tr("Could not copy %1 from the installed instance").arg(new_path));
+            return false;
+        }
+    }
+
     QString configPath = FS::PathCombine(m_stagingPath, "instance.cfg");
     auto instanceSettings = std::make_shared<INISettingsObject>(configPath);
     MinecraftInstance instance(m_globalSettings, instanceSettings, m_stagingPath);
@@ -283,48 +323,33 @@ bool ModrinthCreationTask::createInstance()
         }
     }
 
+    // The metadata only needs the hashes from the index, not the downloaded files, so both can run at the same time
+    QDir folder = FS::PathCombine(instance.modsRoot(), ".index");
+    auto ensureMetadataTask = makeShared<EnsureMetadataTask>(mods, folder, ModPlatform::ResourceProvider::MODRINTH);
+
+    auto installGraph = makeShared<TaskGraph>(tr("Modrinth pack installation"), 2);
+    installGraph->addTask(downloadMods);
+    // writing metadata is best-effort, the mods work without it
+    installGraph->addOptionalTask(ensureMetadataTask);
+
     bool ended_well = false;
 
-    connect(downloadMods.get(), &NetJob::succeeded, this, [&]() { ended_well = true; });
-    connect(downloadMods.get(), &NetJob::failed, [&](const QString& reason) {
-        ended_well = false;
-        setError(reason);
-    });
-    connect(downloadMods.get(), &NetJob::finished, &loop, &QEventLoop::quit);
+    connect(installGraph.get(), &Task::succeeded, this, [&]() { ended_well = true; });
+    connect(downloadMods.get(), &NetJob::failed, [&](const QString& reason) { setError(reason); });
+    connect(installGraph.get(), &Task::finished, &loop, &QEventLoop::quit);
     connect(downloadMods.get(), &NetJob::progress, [&](qint64 current, qint64 total) {
         setDetails(tr("%1 out of %2 complete").arg(current).arg(total));
         setProgress(current, total);
     });
     connect(downloadMods.get(), &NetJob::stepProgress, this, &ModrinthCreationTask::propagateStepProgress);
+    connect(ensureMetadataTask.get(), &Task::stepProgress, this, &ModrinthCreationTask::propagateStepProgress);
 
     setStatus(tr("Downloading mods..."));
-    downloadMods->start();
-    m_task = downloadMods;
+    installGraph->start();
+    m_task = installGraph;
 
     loop.exec();
 
-    if (!ended_well) {
-        for (auto m : mods) {
-            delete m;
-        }
-        return ended_well;
-    }
-
-    QEventLoop ensureMetaLoop;
-    QDir folder = FS::PathCombine(instance.modsRoot(), ".index");
-    auto ensureMetadataTask = makeShared<EnsureMetadataTask>(mods, folder, ModPlatform::ResourceProvider::MODRINTH);
-    connect(ensureMetadataTask.get(), &Task::succeeded, this, [&]() { ended_well = true; });
-    connect(ensureMetadataTask.get(), &Task::finished, &ensureMetaLoop, &QEventLoop::quit);
-    connect(ensureMetadataTask.get(), &Task::progress, [&](qint64 current, qint64 total) {
-        setDetails(tr("%1 out of %2 complete").arg(current).arg(total));
-        setProgress(current, total);
-    });
-    connect(ensureMetadataTask.get(), &Task::stepProgress, this, &ModrinthCreationTask::propagateStepProgress);
-
-    ensureMetadataTask->start();
-    m_task = ensureMetadataTask;
-
-    ensureMetaLoop.exec();
     for (auto m : mods) {
         delete m;
     }
@@ -390,6 +415,7 @@ bool ModrinthCreationTask::parseManifest(const QString& index_path,
                 QJsonObject hashes = Json::requireObject(modInfo, "hashes");
                 file.hash = QByteArray::fromHex(Json::requireString(hashes, "sha512").toLatin1());
                 file.hashAlgorithm = QCryptographicHash::Sha512;
+                file.fileSize = static_cast<qint64>(Json::ensureDouble(modInfo, "fileSize", 0));
 
                 // Do not use requireUrl, which uses StrictMode, instead use QUrl's default TolerantMode
                 // (as Modrinth seems to incorrectly handle spaces)
@@ -4,6 +4,7 @@
 #include "BaseInstance.h"
 #include "InstanceCreationTask.h"
 
+#include "modplatform/helpers/OverrideUtils.h"
 #include "modplatform/modrinth/ModrinthPackManifest.h"
 
 class ModrinthCreationTask final : public InstanceCreationTask {
@@ -39,6 +40,9 @@ class ModrinthCreationTask final : public InstanceCreationTask {
     QString m_managed_id, m_managed_version_id, m_managed_name;
 
     std::vector<Modrinth::File> m_files;
+    // (installed file, path in the new version) of files that only moved between versions
+    QList<std::pair<QString, QString>> m_local_copies;
+    Override::Delta m_overrides_delta, m_client_overrides_delta;
     Task::Ptr m_task;
 
     std::optional<InstancePtr> m_instance;
@@ -56,6 +56,7 @@ struct File {
 
     QCryptographicHash::Algorithm hashAlgorithm;
     QByteArray hash;
+    qint64 fileSize = 0;
     QQueue<QUrl> downloads;
     bool required = true;
 };
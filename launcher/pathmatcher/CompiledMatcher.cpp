@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "CompiledMatcher.h"
+
+#include <algorithm>
+
+CompiledMatcher& CompiledMatcher::addPrefix(const QString& prefix)
+{
+    if (prefix.endsWith('/'))
+        m_prefixes.insert(prefix);
+    else
+        m_exact.insert(prefix);
+    return *this;
+}
+
+CompiledMatcher& CompiledMatcher::addRegexp(const QString& regexp, Qt::CaseSensitivity cs)
+{
+    if (regexp.contains('/'))
+        m_pathRegexps.add(regexp, cs);
+    else
+        m_fileNameRegexps.add(regexp, cs);
+    return *this;
+}
+
+bool CompiledMatcher::matches(const QString& string) const
+{
+    if (m_exact.contains(string))
+        return true;
+    if (!m_prefixes.isEmpty()) {
+        // every prefix ends in a slash, so only the parts of the path up to a slash can be one
+        for (int slash = string.indexOf('/'); slash != -1; slash = string.indexOf('/', slash + 1)) {
+            if (m_prefixes.contains(string.left(slash + 1)))
+                return true;
+        }
+    }
+    if (m_pathRegexps.matches(string))
+        return true;
+    auto slash = string.lastIndexOf('/');
+    return m_fileNameRegexps.matches(slash == -1 ? string : string.mid(slash + 1));
+}
+
+void CompiledMatcher::RegexpSet::add(const QString& regexp, Qt::CaseSensitivity cs)
+{
+    auto options = cs == Qt::CaseInsensitive ? QRegularExpression::CaseInsensitiveOption : QRegularExpression::NoPatternOption;
+
+    // back references are numbered, they would point at the wrong group once merged
+    static const QRegularExpression backReference(R"(\\[1-9gk])");
+    if (regexp.contains(backReference)) {
+        QRegularExpression separate(regexp, options);
+        separate.optimize();
+        this->separate.append(separate);
+        alwaysTest = true;
+    } else {
+        // case sensitivity is per expression, so it goes into the pattern
+        patterns.append(QString("(?%1:%2)").arg(cs == Qt::CaseInsensitive ? "i" : "-i", regexp));
+        combined = QRegularExpression(patterns.join('|'));
+        combined.optimize();
+    }
+
+    auto required = requiredLiterals(regexp);
+    if (required.isEmpty()) {
+        alwaysTest = true;
+        return;
+    }
+    // inline options may turn case sensitivity off for parts of the expression
+    auto literalCs = regexp.contains("(?") ? Qt::CaseInsensitive : cs;
+    for (auto& literal : required) {
+        literals.append(QStringMatcher(literal, literalCs));
+    }
+}
+
+bool CompiledMatcher::RegexpSet::matches(const QString& string) const
+{
+    if (patterns.isEmpty() && separate.isEmpty())
+        return false;
+    if (!alwaysTest) {
+        bool found = false;
+        for (auto& literal : literals) {
+            if (literal.indexIn(string) != -1) {
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            return false;
+    }
+    if (!patterns.isEmpty() && combined.match(string).hasMatch())
+        return true;
+    for (auto& regexp : separate) {
+        if (regexp.match(string).hasMatch())
+            return true;
+    }
+    return false;
+}
+
+// finds the index right after the escape sequence starting at index, including whatever it takes as its payload
+static int skipEscape(const QString& regexp, int index)
+{
+    int size = regexp.size();
+    int i = index + 2;
+    if (index + 1 >= size)
+        return size;
+    auto skipWhile = [&](int max, auto accept) {
+        for (int n = 0; n < max && i < size && accept(regexp[i]); n++)
+            i++;
+        return i;
+    };
+    auto isHex = [](QChar c) { return c.isDigit() || QStringLiteral("abcdefABCDEF").contains(c); };
+    auto isOctal = [](QChar c) { return c >= '0' && c <= '7'; };
+    auto skipDelimited = [&] {
+        if (i >= size)
+            return size;
+        QChar close;
+        if (regexp[i] == '{')
+            close = '}';
+        else if (regexp[i] == '<')
+            close = '>';
+        else if (regexp[i] == '\'')
+            close = '\'';
+        else
+            return i;
+        int end = regexp.indexOf(close, i + 1);
+        return end == -1 ? size : end + 1;
+    };
+
+    switch (regexp[index + 1].unicode()) {
+        case 'Q': {
+            // quoted up to \E, or the end of the pattern
+            int end = regexp.indexOf("\\E", i);
+            return end == -1 ? size : end + 2;
+        }
+        case 'x':
+            return i < size && regexp[i] == '{' ? skipDelimited() : skipWhile(2, isHex);
+        case 'u':
+            return skipWhile(4, isHex);
+        case 'c':
+            return std::min(i + 1, size);
+        case 'o':
+        case 'N':
+        case 'k':
+            return skipDelimited();
+        case 'p':
+        case 'P':
+            return i < size && regexp[i] == '{' ? skipDelimited() : std::min(i + 1, size);
+        case 'g':
+            if (i < size && (regexp[i] == '{' || regexp[i] == '<' || regexp[i] == '\''))
+                return skipDelimited();
+            if (i < size && (regexp[i] == '-' || regexp[i] == '+'))
+                i++;
+            return skipWhile(size, [](QChar c) { return c.isDigit(); });
+        case '0':
+            return skipWhile(2, isOctal);
+        default:
+            // back references, or octal codes when there aren't that many groups
+            if (regexp[index + 1].isDigit())
+                return skipWhile(2, [](QChar c) { return c.isDigit(); });
+            return i;
+    }
+}
+
+// finds the end of the group or character class starting at index, -1 if there is none
+static int skipBracket(const QString& regexp, int index)
+{
+    int depth = 0;
+    bool inClass = false;
+    for (int i = index; i < regexp.size(); i++) {
+        auto c = regexp[i];
+        if (c == '\\') {
+            i = skipEscape(regexp, i) - 1;
+        } else if (inClass) {
+            if (c == ']')
+                inClass = false;
+        } else if (c == '[') {
+            inClass = true;
+            // a closing bracket right at the start is part of the class
+            if (i + 1 < regexp.size() && regexp[i + 1] == '^')
+                i++;
+            if (i + 1 < regexp.size() && regexp[i + 1] == ']')
+                i++;
+        } else if (c == '(') {
+            depth++;
+        } else if (c == ')') {
+            depth--;
+        }
+        if (depth == 0 && !inClass)
+            return i;
+    }
+    return -1;
+}
+
+QStringList CompiledMatcher::requiredLiterals(const QString& regexp)
+{
+    // extended mode changes what counts as a literal, don't bother with it
+    static const QRegularExpression extendedMode(R"(\(\?[a-zA-Z-]*x)");
+    if (regexp.contains(extendedMode))
+        return {};
+
+    // split into the top level alternatives, a match needs a literal from any one of them
+    QStringList alternatives;
+    int start = 0;
+    for (int i = 0; i < regexp.size(); i++) {
+        auto c = regexp[i];
+        if (c == '\\') {
+            i = skipEscape(regexp, i) - 1;
+        } else if (c == '[' || c == '(') {
+            i = skipBracket(regexp, i);
+            if (i == -1)
+                return {};
+        } else if (c == '|') {
+            alternatives.append(regexp.mid(start, i - start));
+            start = i + 1;
+        }
+    }
+    alternatives.append(regexp.mid(start));
+
+    QStringList result;
+    for (auto& alternative : alternatives) {
+        QString best;
+        QString current;
+        auto endLiteral = [&] {
+            if (current.size() > best.size())
+                best = current;
+            current.clear();
+        };
+        for (int i = 0; i < alternative.size();) {
+            auto c = alternative[i];
+            QChar literal;
+            int end = i + 1;
+            if (c == '\\') {
+                end = skipEscape(alternative, i);
+                // escaped letters and digits are classes, anchors, character codes or quoted sections, only treat the others as literals
+                if (end == i + 2 && !alternative[i + 1].isLetterOrNumber())
+                    literal = alternative[i + 1];
+            } else if (c == '[' || c == '(') {
+                auto close = skipBracket(alternative, i);
+                end = close == -1 ? alternative.size() : close + 1;
+            } else if (c == '{') {
+                auto close = alternative.indexOf('}', i);
+                end = close == -1 ? alternative.size() : close + 1;
+            } else if (!QStringLiteral("^$.*+?}").contains(c)) {
+                literal = c;
+            }
+
+            auto quantifier = end < alternative.size() ? alternative[end] : QChar();
+            // these allow zero repetitions, so the character may not be there at all
+            if (quantifier == '*' || quantifier == '?' || quantifier == '{')
+                literal = QChar();
+            if (literal.isNull()) {
+                endLiteral();
+            } else {
+                current += literal;
+                // the character is there at least once, but what follows it is not next to it
+                if (quantifier == '+')
+                    endLiteral();
+            }
+            i = end;
+        }
+        endLiteral();
+        if (best.isEmpty())
+            return {};
+        result.append(best);
+    }
+    return result;
+}
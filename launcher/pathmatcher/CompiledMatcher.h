@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QList>
+#include <QRegularExpression>
+#include <QSet>
+#include <QStringList>
+#include <QStringMatcher>
+#include "IPathMatcher.h"
+
+/** Matches a set of prefixes and regular expressions in one go.
+ *
+ *  Does the same as a MultiMatcher of SimplePrefixMatchers and RegexpMatchers, but is meant for filtering many paths:
+ *  prefixes are looked up per path segment instead of tried one by one, the expressions are merged into a single one,
+ *  and a path only gets to the expressions if it contains a literal that one of them requires.
+ */
+class CompiledMatcher : public IPathMatcher {
+   public:
+    virtual ~CompiledMatcher() {}
+    CompiledMatcher() {}
+
+    /// same rules as SimplePrefixMatcher: with a trailing slash it matches everything inside, otherwise only itself
+    CompiledMatcher& addPrefix(const QString& prefix);
+
+    /// same rules as RegexpMatcher: without a slash in it, only the file name part of the path is tested
+    CompiledMatcher& addRegexp(const QString& regexp, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    virtual bool matches(const QString& string) const override;
+
+    /// literals of which a match of the expression has to contain at least one, empty if there aren't any
+    static QStringList requiredLiterals(const QString& regexp);
+
+   private:
+    struct RegexpSet {
+        QStringList patterns;
+        QList<QStringMatcher> literals;
+        // set when one of the expressions has no usable literal, which makes the prefilter useless
+        bool alwaysTest = false;
+        QRegularExpression combined;
+        // expressions that can't be merged, because they refer to their own groups
+        QList<QRegularExpression> separate;
+
+        void add(const QString& regexp, Qt::CaseSensitivity cs);
+        bool matches(const QString& string) const;
+    };
+
+    QSet<QString> m_exact;
+    QSet<QString> m_prefixes;
+    RegexpSet m_fileNameRegexps;
+    RegexpSet m_pathRegexps;
+};
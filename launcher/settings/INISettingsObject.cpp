@@ -44,13 +44,25 @@ INISettingsObject::INISettingsObject(QString path, QObject* parent) : SettingsOb
     m_ini.loadFile(path);
 }
 
+INISettingsObject::INISettingsObject(QString path, INIFile preloaded, QObject* parent)
+    : SettingsObject(parent), m_ini(std::move(preloaded)), m_filePath(path)
+{}
+
+INISettingsObject::~INISettingsObject()
+{
+    flush();
+}
+
 void INISettingsObject::setFilePath(const QString& filePath)
 {
+    flush();
     m_filePath = filePath;
 }
 
 bool INISettingsObject::reload()
 {
+    flush();
+    waitForWrites();
     return m_ini.loadFile(m_filePath) && SettingsObject::reload();
 }
 
@@ -63,7 +75,8 @@ void INISettingsObject::resumeSave()
 {
     m_suspendSave = false;
     if (m_doSave) {
-        m_ini.saveFile(m_filePath);
+        m_doSave = false;
+        scheduleSave();
     }
 }
 
@@ -91,10 +104,20 @@ void INISettingsObject::doSave()
     if (m_suspendSave) {
         m_doSave = true;
     } else {
-        m_ini.saveFile(m_filePath);
+        scheduleSave();
     }
 }
 
+void INISettingsObject::save()
+{
+    // the copy is cheap, INIFile is implicitly shared and only detaches when the settings change again
+    queueWrite([ini = m_ini, path = m_filePath]() mutable {
+        if (!ini.saveFile(path)) {
+            qWarning() << "Failed to save settings to" << path;
+        }
+    });
+}
+
 void INISettingsObject::resetSetting(const Setting& setting)
 {
     // if we have the setting, remove all the synonyms. ALL OF THEM
@@ -32,6 +32,11 @@ class INISettingsObject : public SettingsObject {
 
     explicit INISettingsObject(QString path, QObject* parent = nullptr);
 
+    /** Uses 'preloaded' as the contents of 'path' instead of reading it again. */
+    INISettingsObject(QString path, INIFile preloaded, QObject* parent = nullptr);
+
+    ~INISettingsObject() override;
+
     /*!
      * \brief Gets the path to the INI file.
      * \return The path to the INI file.
@@ -55,6 +60,7 @@ class INISettingsObject : public SettingsObject {
 
    protected:
     virtual QVariant retrieveValue(const Setting& setting) override;
+    void save() override;
     void doSave();
 
    protected:
@@ -19,15 +19,136 @@
 #include "settings/OverrideSetting.h"
 #include "settings/Setting.h"
 
+#include <QCoreApplication>
+#include <QMutex>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
 #include <QVariant>
+#include <QtConcurrentRun>
 
-SettingsObject::SettingsObject(QObject* parent) : QObject(parent) {}
+#include <atomic>
+
+namespace {
+// long enough to fold a burst of changes into one write, short enough that nothing is lost on a crash in practice
+const int SAVE_DELAY_MS = 500;
+
+// settings objects with a save timer running
+QSet<SettingsObject*> s_pendingSaves;
+QMutex s_pendingSavesLock;
+
+// set once the application is shutting down, the I/O thread isn't waited on after that
+std::atomic<bool> s_writeInline = false;
+
+QThreadPool* settingsIOPool()
+{
+    // a single thread keeps writes to the same file in order
+    static QThreadPool* pool = [] {
+        auto pool = new QThreadPool();
+        pool->setMaxThreadCount(1);
+        return pool;
+    }();
+    return pool;
+}
+
+bool onMainThread()
+{
+    return QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread();
+}
+}  // namespace
+
+SettingsObject::SettingsObject(QObject* parent) : QObject(parent)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SAVE_DELAY_MS);
+    connect(&m_saveTimer, &QTimer::timeout, this, &SettingsObject::flush);
+}
 
 SettingsObject::~SettingsObject()
 {
+    {
+        QMutexLocker locker(&s_pendingSavesLock);
+        s_pendingSaves.remove(this);
+    }
     m_settings.clear();
 }
 
+void SettingsObject::scheduleSave()
+{
+    if (m_discarded)
+        return;
+    if (!onMainThread() || thread() != QThread::currentThread()) {
+        save();
+        return;
+    }
+    {
+        QMutexLocker locker(&s_pendingSavesLock);
+        s_pendingSaves.insert(this);
+    }
+    m_saveTimer.start();
+}
+
+void SettingsObject::flush()
+{
+    {
+        QMutexLocker locker(&s_pendingSavesLock);
+        if (!s_pendingSaves.remove(this))
+            return;
+    }
+    if (thread() == QThread::currentThread())
+        m_saveTimer.stop();
+    save();
+}
+
+void SettingsObject::flushAll()
+{
+    QList<SettingsObject*> pending;
+    {
+        QMutexLocker locker(&s_pendingSavesLock);
+        pending = s_pendingSaves.values();
+    }
+    for (auto object : pending) {
+        object->flush();
+    }
+    waitForWrites();
+}
+
+void SettingsObject::shutdown()
+{
+    flushAll();
+    // settings objects destroyed from here on write in their destructor, nothing would wait for the I/O thread
+    s_writeInline = true;
+    settingsIOPool()->waitForDone();
+}
+
+void SettingsObject::discardChanges()
+{
+    m_discarded = true;
+    {
+        QMutexLocker locker(&s_pendingSavesLock);
+        s_pendingSaves.remove(this);
+    }
+    if (thread() == QThread::currentThread())
+        m_saveTimer.stop();
+    // a write already handed to the I/O thread must not land after the files are gone
+    waitForWrites();
+}
+
+void SettingsObject::queueWrite(std::function<void()> write)
+{
+    if (!onMainThread() || QCoreApplication::closingDown() || s_writeInline) {
+        write();
+        return;
+    }
+    auto future = QtConcurrent::run(settingsIOPool(), std::move(write));
+    Q_UNUSED(future);
+}
+
+void SettingsObject::waitForWrites()
+{
+    settingsIOPool()->waitForDone();
+}
+
 std::shared_ptr<Setting> SettingsObject::registerOverride(std::shared_ptr<Setting> original, std::shared_ptr<Setting> gate)
 {
     if (contains(original->id())) {
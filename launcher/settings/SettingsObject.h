@@ -20,7 +20,9 @@
 #include <QMap>
 #include <QObject>
 #include <QStringList>
+#include <QTimer>
 #include <QVariant>
+#include <functional>
 #include <memory>
 
 class Setting;
@@ -141,6 +143,29 @@ class SettingsObject : public QObject {
 
     virtual void suspendSave() = 0;
     virtual void resumeSave() = 0;
+
+    /*!
+     * \brief Starts writing any pending changes right away instead of waiting for the save timer.
+     */
+    void flush();
+
+    /*!
+     * \brief Flushes every settings object and waits until all writes are on disk.
+     * Call this before reading or moving settings files directly, and on exit.
+     */
+    static void flushAll();
+
+    /*!
+     * \brief Flushes everything like flushAll(), and writes any later change right away instead of queueing it.
+     * Call this once the application is shutting down.
+     */
+    static void shutdown();
+
+    /*!
+     * \brief Drops the changes waiting for the save timer and stops writing from now on.
+     * Call this before the settings file, or the folder holding it, gets removed.
+     */
+    void discardChanges();
    signals:
     /*!
      * \brief Signal emitted when one of this SettingsObject object's settings changes.
@@ -193,12 +218,36 @@ class SettingsObject : public QObject {
      */
     virtual QVariant retrieveValue(const Setting& setting) = 0;
 
+    /*!
+     * \brief Asks for save() to be called soon, so a burst of changes is written only once.
+     * Objects living outside the main thread save immediately, as there may be no event loop to run the timer.
+     */
+    void scheduleSave();
+
+    /*!
+     * \brief Writes the settings out. Called by the save timer and by flush().
+     */
+    virtual void save() {}
+
+    /*!
+     * \brief Runs a write on the settings I/O thread, in the order writes were queued.
+     * Runs it right away when called outside the main thread.
+     */
+    static void queueWrite(std::function<void()> write);
+
+    /*!
+     * \brief Waits until all queued writes are done.
+     */
+    static void waitForWrites();
+
     friend class Setting;
 
    private:
     QMap<QString, std::shared_ptr<Setting>> m_settings;
+    QTimer m_saveTimer;
 
    protected:
     bool m_suspendSave = false;
     bool m_doSave = false;
+    bool m_discarded = false;
 };
@@ -104,6 +104,7 @@ void ConcurrentTask::clear()
     m_failed.clear();
     m_queue.clear();
     m_task_progress.clear();
+    m_pending_steps.clear();
 
     m_progress = 0;
 }
@@ -162,6 +163,7 @@ void ConcurrentTask::subTaskFinished(Task::Ptr task, TaskStepState state)
     auto task_progress = *m_task_progress.value(task->getUid());
     task_progress.state = state;
     m_task_progress.remove(task->getUid());
+    m_pending_steps.remove(task->getUid());
 
     disconnect(task.get(), 0, this, 0);
 
@@ -186,7 +188,8 @@ void ConcurrentTask::subTaskStatus(Task::Ptr task, const QString& msg)
     task_progress->status = msg;
     task_progress->state = TaskStepState::Running;
 
-    emit stepProgress(*task_progress);
+    m_pending_steps.insert(task->getUid());
+    scheduleProgress();
 
     if (totalSize() == 1) {
         setStatus(msg);
@@ -199,7 +202,8 @@ void ConcurrentTask::subTaskDetails(Task::Ptr task, const QString& msg)
     task_progress->details = msg;
     task_progress->state = TaskStepState::Running;
 
-    emit stepProgress(*task_progress);
+    m_pending_steps.insert(task->getUid());
+    scheduleProgress();
 
     if (totalSize() == 1) {
         setDetails(msg);
@@ -212,14 +216,26 @@ void ConcurrentTask::subTaskProgress(Task::Ptr task, qint64 current, qint64 tota
 
     task_progress->update(current, total);
 
-    emit stepProgress(*task_progress);
-    updateState();
+    m_pending_steps.insert(task->getUid());
+    scheduleProgress();
 
     if (totalSize() == 1) {
         setProgress(task_progress->current, task_progress->total);
     }
 }
 
+void ConcurrentTask::flushProgress()
+{
+    Task::flushProgress();
+
+    auto steps = m_pending_steps;
+    m_pending_steps.clear();
+    for (auto& uid : steps) {
+        if (auto task_progress = m_task_progress.value(uid))
+            emit stepProgress(*task_progress);
+    }
+}
+
 void ConcurrentTask::updateState()
 {
     if (totalSize() > 1) {
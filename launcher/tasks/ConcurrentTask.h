@@ -81,6 +81,8 @@ class ConcurrentTask : public Task {
     void subTaskDetails(Task::Ptr task, const QString& msg);
     void subTaskProgress(Task::Ptr task, qint64 current, qint64 total);
 
+    void flushProgress() override;
+
    protected:
     // NOTE: This is not thread-safe.
     [[nodiscard]] unsigned int totalSize() const { return static_cast<unsigned int>(m_queue.size() + m_doing.size() + m_done.size()); }
@@ -98,6 +100,8 @@ class ConcurrentTask : public Task {
     QHash<Task*, Task::Ptr> m_succeeded;
 
     QHash<QUuid, std::shared_ptr<TaskStepProgress>> m_task_progress;
+    // steps updated since the last frame
+    QSet<QUuid> m_pending_steps;
 
     int m_total_max_size;
 };
@@ -37,9 +37,14 @@
 #include "Task.h"
 
 #include <QDebug>
+#include <QThread>
+#include <QTimer>
 
 Q_LOGGING_CATEGORY(taskLogC, "launcher.task")
 
+// plenty for a progress bar, and keeps tasks with thousands of tiny steps from flooding the UI
+static const qint64 PROGRESS_FRAME_MS = 1000 / 30;
+
 Task::Task(bool show_debug) : m_show_debug(show_debug)
 {
     m_uid = QUuid::createUuid();
@@ -64,12 +69,46 @@ void Task::setDetails(const QString& new_details)
 
 void Task::setProgress(qint64 current, qint64 total)
 {
-    if ((m_progress != current) || (m_progressTotal != total)) {
-        m_progress = current;
-        m_progressTotal = total;
+    auto changed = m_progress.exchange(current) != current;
+    changed = m_progressTotal.exchange(total) != total || changed;
+    if (changed) {
+        m_progressChanged = true;
+        scheduleProgress();
+    }
+}
+
+void Task::advanceProgress(qint64 amount)
+{
+    m_progress += amount;
+    m_progressChanged = true;
+    scheduleProgress();
+}
+
+void Task::scheduleProgress()
+{
+    if (m_progressScheduled.exchange(true))
+        return;  // the pending frame picks the new values up
+    if (QThread::currentThread() == thread())
+        startProgressFrame();
+    else
+        QMetaObject::invokeMethod(this, &Task::startProgressFrame, Qt::QueuedConnection);
+}
 
+void Task::startProgressFrame()
+{
+    auto wait = m_lastProgress.isValid() ? PROGRESS_FRAME_MS - m_lastProgress.elapsed() : 0;
+    if (wait > 0)
+        QTimer::singleShot(static_cast<int>(wait), this, &Task::flushProgress);
+    else
+        flushProgress();
+}
+
+void Task::flushProgress()
+{
+    m_progressScheduled = false;
+    m_lastProgress.start();
+    if (m_progressChanged.exchange(false))
         emit progress(m_progress, m_progressTotal);
-    }
 }
 
 void Task::start()
@@ -114,6 +153,7 @@ void Task::emitFailed(QString reason)
         qCCritical(taskLogC) << "Task" << describe() << "failed while not running!!!!: " << reason;
         return;
     }
+    flushProgress();
     m_state = State::Failed;
     m_failReason = reason;
     qCCritical(taskLogC) << "Task" << describe() << "failed: " << reason;
@@ -128,6 +168,7 @@ void Task::emitAborted()
         qCCritical(taskLogC) << "Task" << describe() << "aborted while not running!!!!";
         return;
     }
+    flushProgress();
     m_state = State::AbortedByUser;
     m_failReason = "Aborted.";
     if (m_show_debug)
@@ -143,6 +184,7 @@ void Task::emitSucceeded()
         qCCritical(taskLogC) << "Task" << describe() << "succeeded while not running!!!!";
         return;
     }
+    flushProgress();
     m_state = State::Succeeded;
     if (m_show_debug)
         qCDebug(taskLogC) << "Task" << describe() << "succeeded";
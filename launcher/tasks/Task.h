@@ -36,10 +36,13 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QLoggingCategory>
 #include <QRunnable>
 #include <QUuid>
 
+#include <atomic>
+
 #include "QObjectPtr.h"
 
 Q_DECLARE_LOGGING_CATEGORY(taskLogC)
@@ -124,6 +127,11 @@ class Task : public QObject, public QRunnable {
    protected:
     void logWarning(const QString& line);
 
+    /** Asks for flushProgress() to run on the task's thread, at most once per frame.
+     *  Safe to call from any thread.
+     */
+    void scheduleProgress();
+
    private:
     QString describe();
 
@@ -170,10 +178,21 @@ class Task : public QObject, public QRunnable {
 
     virtual void propagateStepProgress(TaskStepProgress const& task_progress);
 
+    /** Emits the progress accumulated since the last frame.
+     *  Called once per frame after scheduleProgress(), and right before the task finishes.
+     */
+    virtual void flushProgress();
+
+   private slots:
+    void startProgressFrame();
+
    public slots:
     void setStatus(const QString& status);
     void setDetails(const QString& details);
+    /** Safe to call from any thread, the progress signal is emitted on the task's thread at most once per frame.
+     */
     void setProgress(qint64 current, qint64 total);
+    void advanceProgress(qint64 amount = 1);
 
    protected:
     State m_state = State::Inactive;
@@ -181,8 +200,8 @@ class Task : public QObject, public QRunnable {
     QString m_failReason = "";
     QString m_status;
     QString m_details;
-    int m_progress = 0;
-    int m_progressTotal = 100;
+    std::atomic<qint64> m_progress{ 0 };
+    std::atomic<qint64> m_progressTotal{ 100 };
 
     // TODO: Nuke in favor of QLoggingCategory
     bool m_show_debug = true;
@@ -191,4 +210,8 @@ class Task : public QObject, public QRunnable {
     // Change using setAbortStatus
     bool m_can_abort = false;
     QUuid m_uid;
+
+    std::atomic<bool> m_progressChanged{ false };
+    std::atomic<bool> m_progressScheduled{ false };
+    QElapsedTimer m_lastProgress;
 };
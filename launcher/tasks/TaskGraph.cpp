@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+
+#include <QDebug>
+
+TaskGraph::TaskGraph(QString task_name, int max_concurrent) : ConcurrentTask(task_name, max_concurrent) {}
+
+void TaskGraph::addTask(Task::Ptr task, QList<Task::Ptr> dependencies)
+{
+    if (!dependencies.isEmpty())
+        m_dependencies.insert(task.get(), dependencies);
+    ConcurrentTask::addTask(task);
+}
+
+void TaskGraph::addOptionalTask(Task::Ptr task, QList<Task::Ptr> dependencies)
+{
+    m_optional.insert(task.get());
+    addTask(task, dependencies);
+}
+
+void TaskGraph::subTaskFailed(Task::Ptr task, const QString& msg)
+{
+    if (m_optional.contains(task.get())) {
+        qWarning() << "Optional task" << task->objectName() << "failed, continuing without it:" << msg;
+        subTaskFinished(task, TaskStepState::Succeeded);
+        return;
+    }
+    ConcurrentTask::subTaskFailed(task, msg);
+}
+
+auto TaskGraph::readiness(Task* task) const -> Readiness
+{
+    for (auto const& dependency : m_dependencies.value(task)) {
+        if (m_failed.contains(dependency.get()))
+            return Readiness::Blocked;
+        if (!m_succeeded.contains(dependency.get()))
+            return Readiness::Waiting;
+    }
+    return Readiness::Ready;
+}
+
+void TaskGraph::executeNextSubTask()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    // A finished subtask can unblock several others at once, so start everything that became ready
+    bool changed = true;
+    while (changed && m_doing.count() < m_total_max_size) {
+        changed = false;
+        for (auto it = m_queue.begin(); it != m_queue.end(); it++) {
+            auto task = *it;
+            auto state = readiness(task.get());
+            if (state == Readiness::Waiting)
+                continue;
+
+            m_queue.erase(it);
+            if (state == Readiness::Blocked) {
+                qWarning() << "Not running" << task->objectName() << "as one of its dependencies failed";
+                m_done.insert(task.get(), task);
+                m_failed.insert(task.get(), task);
+                updateState();
+            } else {
+                startSubTask(task);
+            }
+            changed = true;
+            break;
+        }
+    }
+
+    if (m_doing.isEmpty()) {
+        if (!m_queue.isEmpty()) {
+            // nothing is running and nothing can start, the remaining tasks depend on each other
+            qCritical() << "Dependency cycle between the remaining" << m_queue.size() << "tasks of" << objectName();
+            for (auto task : m_queue) {
+                m_done.insert(task.get(), task);
+                m_failed.insert(task.get(), task);
+            }
+            m_queue.clear();
+        }
+        if (m_failed.isEmpty())
+            emitSucceeded();
+        else
+            emitFailed(tr("One or more subtasks failed"));
+    }
+}
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "ConcurrentTask.h"
+
+/** A concurrent task where subtasks can depend on other subtasks.
+ *
+ *  A subtask is only started once all of its dependencies have succeeded, so independent branches
+ *  run at the same time while each step still waits for its inputs. When a dependency fails, the tasks
+ *  depending on it are never started and are counted as failed.
+ */
+class TaskGraph : public ConcurrentTask {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<TaskGraph>;
+
+    explicit TaskGraph(QString task_name = "", int max_concurrent = 6);
+    ~TaskGraph() override = default;
+
+    // dependencies must have been added to the graph too
+    void addTask(Task::Ptr task, QList<Task::Ptr> dependencies = {});
+    // a failure of this task is only logged, neither the graph nor the tasks depending on it fail because of it
+    void addOptionalTask(Task::Ptr task, QList<Task::Ptr> dependencies = {});
+
+   protected slots:
+    void executeNextSubTask() override;
+    void subTaskFailed(Task::Ptr task, const QString& msg) override;
+
+   private:
+    enum class Readiness { Waiting, Ready, Blocked };
+    Readiness readiness(Task* task) const;
+
+   private:
+    QHash<Task*, QList<Task::Ptr>> m_dependencies;
+    QSet<Task*> m_optional;
+};
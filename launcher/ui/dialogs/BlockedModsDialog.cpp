@@ -27,8 +27,12 @@
 #include "ui_BlockedModsDialog.h"
 
 #include "Application.h"
+#include "FileSystem.h"
+#include "Json.h"
+#include "StringUtils.h"
 #include "modplatform/helpers/HashUtils.h"
 
+#include <QDateTime>
 #include <QDebug>
 #include <QDesktopServices>
 #include <QDialogButtonBox>
@@ -37,11 +41,19 @@
 #include <QDragEnterEvent>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QJsonObject>
 #include <QMimeData>
 #include <QPushButton>
 #include <QStandardPaths>
 #include <QTimer>
 
+namespace {
+QString hashIndexPath()
+{
+    return FS::PathCombine(APPLICATION->metacache()->getBasePath("general"), "blocked_mod_hashes.json");
+}
+}  // namespace
+
 BlockedModsDialog::BlockedModsDialog(QWidget* parent, const QString& title, const QString& text, QList<BlockedMod>& mods, QString hash_type)
     : QDialog(parent), ui(new Ui::BlockedModsDialog), m_mods(mods), m_hash_type(hash_type)
 {
@@ -59,10 +71,19 @@ BlockedModsDialog::BlockedModsDialog(QWidget* parent, const QString& title, cons
     auto downloadFolderButton = ui->buttonBox->addButton(tr("Add Download Folder"), QDialogButtonBox::ActionRole);
     connect(downloadFolderButton, &QPushButton::clicked, this, &BlockedModsDialog::addDownloadFolder);
 
-    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &BlockedModsDialog::directoryChanged);
+    connect(&m_watcher, &FileWatcher::directoryChanged, this, &BlockedModsDialog::directoryChanged);
 
     qDebug() << "[Blocked Mods Dialog] Mods List: " << mods;
 
+    for (int i = 0; i < m_mods.size(); i++) {
+        auto& mod = m_mods[i];
+        m_names[mod.name.toLower()].append(i);
+        m_lax_names[StringUtils::laxName(mod.name)].append(i);
+        if (!mod.hash.isEmpty())
+            m_hashes[mod.hash.toLower()].append(i);
+    }
+    loadHashIndex();
+
     // defer setup of file system watchers until after the dialog is shown
     // this allows OS (namely macOS) permission prompts to show after the relevant dialog appears
     QTimer::singleShot(0, this, [this] {
@@ -122,7 +143,8 @@ void BlockedModsDialog::dropEvent(QDropEvent* e)
 void BlockedModsDialog::done(int r)
 {
     QDialog::done(r);
-    disconnect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &BlockedModsDialog::directoryChanged);
+    disconnect(&m_watcher, &FileWatcher::directoryChanged, this, &BlockedModsDialog::directoryChanged);
+    saveHashIndex();
 }
 
 void BlockedModsDialog::openAll(bool missingOnly)
@@ -186,7 +208,12 @@ void BlockedModsDialog::update()
 void BlockedModsDialog::directoryChanged(QString path)
 {
     qDebug() << "[Blocked Mods Dialog] Directory changed: " << path;
-    validateMatchedMods();
+    if (validateMatchedMods()) {
+        // a matched file went away, so files we skipped before may be candidates again
+        m_dir_snapshots.clear();
+        scanPaths();
+        return;
+    }
     scanPath(path, true);
 }
 
@@ -234,21 +261,31 @@ void BlockedModsDialog::scanPaths()
 }
 
 /// @brief Scan the directory at path, skip paths that do not contain a file name
-///        of a blocked mod we are looking for
+///        of a blocked mod we are looking for and files unchanged since the last scan
 /// @param path the directory to scan
 void BlockedModsDialog::scanPath(QString path, bool start_task)
 {
-    QDir scan_dir(path);
+    auto& snapshot = m_dir_snapshots[path];
+    QHash<QString, FileStamp> current;
     QDirIterator scan_it(path, QDir::Filter::Files | QDir::Filter::Hidden, QDirIterator::NoIteratorFlags);
     while (scan_it.hasNext()) {
-        QString file = scan_it.next();
+        scan_it.next();
+        auto file = scan_it.fileInfo();
+        FileStamp stamp{ file.size(), file.lastModified().toMSecsSinceEpoch() };
+        current.insert(file.filePath(), stamp);
+
+        auto seen = snapshot.constFind(file.filePath());
+        if (seen != snapshot.constEnd() && *seen == stamp) {
+            continue;
+        }
 
         if (!checkValidPath(file)) {
             continue;
         }
 
-        addHashTask(file);
+        addHashTask(file.filePath());
     }
+    snapshot = std::move(current);
 
     if (start_task) {
         runHashTask();
@@ -263,6 +300,23 @@ void BlockedModsDialog::addHashTask(QString path)
     m_pending_hash_paths.insert(path);
 }
 
+/// @brief check the file located at path against the hash index instead of hashing it again
+/// @param path the path to the local file
+/// @return boolean: was an up to date hash found for the file?
+bool BlockedModsDialog::checkCachedHash(QString path)
+{
+    auto cached = m_hash_index.constFind(path);
+    if (cached == m_hash_index.constEnd())
+        return false;
+
+    QFileInfo file(path);
+    if (!(cached->stamp == FileStamp{ file.size(), file.lastModified().toMSecsSinceEpoch() }))
+        return false;
+
+    checkMatchHash(cached->hash, path);
+    return true;
+}
+
 /// @brief add a hashing task for the file located at path and connect it to check that hash against
 ///        our blocked mods list
 /// @param path the path to the local file being hashed
@@ -272,7 +326,14 @@ void BlockedModsDialog::buildHashTask(QString path)
 
     qDebug() << "[Blocked Mods Dialog] Creating Hash task for path: " << path;
 
-    connect(hash_task.get(), &Task::succeeded, this, [this, hash_task, path] { checkMatchHash(hash_task->getResult(), path); });
+    // stamp the file before hashing, if it changes meanwhile the new stamp won't match and it gets hashed again
+    QFileInfo file(path);
+    FileStamp stamp{ file.size(), file.lastModified().toMSecsSinceEpoch() };
+    connect(hash_task.get(), &Task::succeeded, this, [this, hash_task, path, stamp] {
+        m_hash_index.insert(path, { stamp, hash_task->getResult() });
+        m_hash_index_dirty = true;
+        checkMatchHash(hash_task->getResult(), path);
+    });
     connect(hash_task.get(), &Task::failed, this, [path] { qDebug() << "Failed to hash path: " << path; });
 
     m_hashing_task->addTask(hash_task);
@@ -284,81 +345,52 @@ void BlockedModsDialog::buildHashTask(QString path)
 /// @param path the path to the local file being compared
 void BlockedModsDialog::checkMatchHash(QString hash, QString path)
 {
-    bool match = false;
-
     qDebug() << "[Blocked Mods Dialog] Checking for match on hash: " << hash << "| From path:" << path;
 
-    for (auto& mod : m_mods) {
+    for (auto i : m_hashes.value(hash.toLower())) {
+        auto& mod = m_mods[i];
         if (mod.matched) {
             continue;
         }
-        if (mod.hash.compare(hash, Qt::CaseInsensitive) == 0) {
-            mod.matched = true;
-            mod.localPath = path;
-            match = true;
-
-            qDebug() << "[Blocked Mods Dialog] Hash match found:" << mod.name << hash << "| From path:" << path;
+        mod.matched = true;
+        mod.localPath = path;
 
-            break;
-        }
-    }
+        qDebug() << "[Blocked Mods Dialog] Hash match found:" << mod.name << hash << "| From path:" << path;
 
-    if (match) {
         update();
+        return;
     }
 }
 
-/// @brief Check if the name of the file at path matches the name of a blocked mod we are searching for
-/// @param path the path to check
-/// @return boolean: did the path match the name of a blocked mod?
-bool BlockedModsDialog::checkValidPath(QString path)
+/// @brief Check if the name of the file matches the name of a blocked mod we are searching for,
+///        and that its size matches that mod when the platform told us the expected size
+/// @param file the file to check
+/// @return boolean: is the file worth hashing?
+bool BlockedModsDialog::checkValidPath(const QFileInfo& file)
 {
-    const QFileInfo file = QFileInfo(path);
     const QString filename = file.fileName();
+    const QString path = file.filePath();
 
-    auto compare = [](QString fsFilename, QString metadataFilename) {
-        return metadataFilename.compare(fsFilename, Qt::CaseInsensitive) == 0;
-    };
-
-    // super lax compare (but not fuzzy)
-    // convert to lowercase
-    // convert all speratores to whitespace
-    // simplify sequence of internal whitespace to a single space
-    // efectivly compare two strings ignoring all separators and case
-    auto laxCompare = [](QString fsfilename, QString metadataFilename) {
-        // allowed character seperators
-        QList<QChar> allowedSeperators = { '-', '+', '.', '_' };
-
-        // copy in lowercase
-        auto fsName = fsfilename.toLower();
-        auto metaName = metadataFilename.toLower();
-
-        // replace all potential allowed seperatores with whitespace
-        for (auto sep : allowedSeperators) {
-            fsName = fsName.replace(sep, ' ');
-            metaName = metaName.replace(sep, ' ');
-        }
-
-        // remove extraneous whitespace
-        fsName = fsName.simplified();
-        metaName = metaName.simplified();
-
-        return fsName.compare(metaName) == 0;
-    };
+    auto sizeMatches = [&file](const BlockedMod& mod) { return mod.size < 0 || mod.size == file.size(); };
 
-    for (auto& mod : m_mods) {
-        if (compare(filename, mod.name)) {
-            // if the mod is not yet matched and doesn't have a hash then
-            // just match it with the file that has the exact same name
-            if (!mod.matched && mod.hash.isEmpty()) {
-                mod.matched = true;
-                mod.localPath = path;
-                return false;
-            }
+    for (auto i : m_names.value(filename.toLower())) {
+        auto& mod = m_mods[i];
+        // if the mod is not yet matched and doesn't have a hash then
+        // just match it with the file that has the exact same name
+        if (!mod.matched && mod.hash.isEmpty()) {
+            mod.matched = true;
+            mod.localPath = path;
+            return false;
+        }
+        if (!mod.matched && sizeMatches(mod)) {
             qDebug() << "[Blocked Mods Dialog] Name match found:" << mod.name << "| From path:" << path;
             return true;
         }
-        if (laxCompare(filename, mod.name)) {
+    }
+
+    for (auto i : m_lax_names.value(StringUtils::laxName(filename))) {
+        auto& mod = m_mods[i];
+        if (!mod.matched && !mod.hash.isEmpty() && sizeMatches(mod)) {
             qDebug() << "[Blocked Mods Dialog] Lax name match found:" << mod.name << "| From path:" << path;
             return true;
         }
@@ -373,7 +405,8 @@ bool BlockedModsDialog::allModsMatched()
 }
 
 /// @brief ensure matched file paths still exist
-void BlockedModsDialog::validateMatchedMods()
+/// @return boolean: was any mod marked as not matched?
+bool BlockedModsDialog::validateMatchedMods()
 {
     bool changed = false;
     for (auto& mod : m_mods) {
@@ -391,6 +424,7 @@ void BlockedModsDialog::validateMatchedMods()
     if (changed) {
         update();
     }
+    return changed;
 }
 
 /// @brief run hash task or mark a pending run if it is already running
@@ -402,13 +436,18 @@ void BlockedModsDialog::runHashTask()
         if (!m_pending_hash_paths.isEmpty()) {
             qDebug() << "[Blocked Mods Dialog] there are pending hash tasks, building and running tasks";
 
+            bool added = false;
             auto path = m_pending_hash_paths.begin();
             while (path != m_pending_hash_paths.end()) {
-                buildHashTask(*path);
+                if (!checkCachedHash(*path)) {
+                    buildHashTask(*path);
+                    added = true;
+                }
                 path = m_pending_hash_paths.erase(path);
             }
 
-            m_hashing_task->start();
+            if (added)
+                m_hashing_task->start();
         }
     } else {
         qDebug() << "[Blocked Mods Dialog] queueing another run of the hashing task";
@@ -423,6 +462,62 @@ void BlockedModsDialog::hashTaskFinished()
     if (m_rehash_pending) {
         qDebug() << "[Blocked Mods Dialog] task finished with a rehash pending, rerunning";
         runHashTask();
+        return;
+    }
+    saveHashIndex();
+}
+
+void BlockedModsDialog::loadHashIndex()
+{
+    auto path = hashIndexPath();
+    if (!QFileInfo::exists(path))
+        return;
+    try {
+        auto files = Json::ensureObject(Json::requireObject(Json::requireDocument(path)), m_hash_type);
+        for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+            auto entry = Json::requireObject(it.value());
+            FileStamp stamp{ static_cast<qint64>(Json::requireDouble(entry, "size")),
+                             static_cast<qint64>(Json::requireDouble(entry, "mtime")) };
+            m_hash_index.insert(it.key(), { stamp, Json::requireString(entry, "hash") });
+        }
+    } catch (const Exception& e) {
+        qWarning() << "[Blocked Mods Dialog] Failed to read the hash index:" << e.cause();
+        m_hash_index.clear();
+    }
+}
+
+void BlockedModsDialog::saveHashIndex()
+{
+    if (!m_hash_index_dirty)
+        return;
+    m_hash_index_dirty = false;
+
+    auto path = hashIndexPath();
+    QJsonObject root;
+    try {
+        if (QFileInfo::exists(path))
+            root = Json::requireObject(Json::requireDocument(path));
+    } catch (const Exception& e) {
+        qWarning() << "[Blocked Mods Dialog] Replacing unreadable hash index:" << e.cause();
+    }
+
+    QJsonObject files;
+    for (auto it = m_hash_index.constBegin(); it != m_hash_index.constEnd(); ++it) {
+        // don't let the index grow forever with files the user has since deleted
+        if (!QFileInfo::exists(it.key()))
+            continue;
+        QJsonObject entry;
+        entry.insert("size", it->stamp.size);
+        entry.insert("mtime", it->stamp.mtime);
+        entry.insert("hash", it->hash);
+        files.insert(it.key(), entry);
+    }
+    root.insert(m_hash_type, files);
+
+    try {
+        Json::write(root, path);
+    } catch (const Exception& e) {
+        qWarning() << "[Blocked Mods Dialog] Failed to save the hash index:" << e.cause();
     }
 }
 
@@ -432,7 +527,7 @@ QDebug operator<<(QDebug debug, const BlockedMod& m)
     QDebugStateSaver saver(debug);
 
     debug.nospace() << "{ name: " << m.name << ", websiteUrl: " << m.websiteUrl << ", hash: " << m.hash << ", matched: " << m.matched
-                    << ", localPath: " << m.localPath << "}";
+                    << ", localPath: " << m.localPath << ", size: " << m.size << "}";
 
     return debug;
 }
@@ -26,13 +26,14 @@
 #pragma once
 
 #include <QDialog>
+#include <QHash>
 #include <QList>
 #include <QString>
 
-#include <QFileSystemWatcher>
-
+#include "FileWatcher.h"
 #include "tasks/ConcurrentTask.h"
 
+class QFileInfo;
 class QPushButton;
 
 struct BlockedMod {
@@ -42,6 +43,7 @@ struct BlockedMod {
     bool matched;
     QString localPath;
     QString targetFolder;
+    qint64 size = -1;  // expected file size in bytes, -1 if the platform didn't tell us
 };
 
 QT_BEGIN_NAMESPACE
@@ -66,15 +68,37 @@ class BlockedModsDialog : public QDialog {
     void done(int r) override;
 
    private:
+    struct FileStamp {
+        qint64 size;
+        qint64 mtime;
+        bool operator==(const FileStamp& other) const { return size == other.size && mtime == other.mtime; }
+    };
+    struct CachedHash {
+        FileStamp stamp;
+        QString hash;
+    };
+
     Ui::BlockedModsDialog* ui;
     QList<BlockedMod>& m_mods;
-    QFileSystemWatcher m_watcher;
+    FileWatcher m_watcher;
     shared_qobject_ptr<ConcurrentTask> m_hashing_task;
     QSet<QString> m_pending_hash_paths;
     bool m_rehash_pending;
     QPushButton* m_openMissingButton;
     QString m_hash_type;
 
+    // lookup tables into m_mods, built once as the list doesn't change while the dialog is open
+    QHash<QString, QList<int>> m_names;
+    QHash<QString, QList<int>> m_lax_names;
+    QHash<QString, QList<int>> m_hashes;
+
+    // watched directory -> the files seen in it on the last scan, so rescans only look at what changed
+    QHash<QString, QHash<QString, FileStamp>> m_dir_snapshots;
+
+    // persisted path -> hash index for m_hash_type, so files are only hashed again once they change
+    QHash<QString, CachedHash> m_hash_index;
+    bool m_hash_index_dirty = false;
+
     void openAll(bool missingOnly);
     void addDownloadFolder();
     void update();
@@ -84,13 +108,16 @@ class BlockedModsDialog : public QDialog {
     void scanPaths();
     void scanPath(QString path, bool start_task);
     void addHashTask(QString path);
+    bool checkCachedHash(QString path);
     void buildHashTask(QString path);
     void checkMatchHash(QString hash, QString path);
-    void validateMatchedMods();
+    bool validateMatchedMods();
     void runHashTask();
     void hashTaskFinished();
+    void loadHashIndex();
+    void saveHashIndex();
 
-    bool checkValidPath(QString path);
+    bool checkValidPath(const QFileInfo& file);
     bool allModsMatched();
 };
 
@@ -51,6 +51,7 @@
 #include <icons/IconList.h>
 #include <QDebug>
 #include <QFileInfo>
+#include <QLocale>
 #include <QPushButton>
 #include <QSaveFile>
 #include <QSortFilterProxyModel>
@@ -80,6 +81,8 @@ ExportInstanceDialog::ExportInstanceDialog(InstancePtr instance, QWidget* parent
     ui->treeView->sortByColumn(0, Qt::AscendingOrder);
 
     connect(proxyModel, SIGNAL(rowsInserted(QModelIndex, int, int)), SLOT(rowsInserted(QModelIndex, int, int)));
+    connect(proxyModel, &FileIgnoreProxy::sizesChanged, this, &ExportInstanceDialog::updateSize);
+    updateSize();
 
     model->setFilter(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::AllDirs | QDir::Hidden);
     model->setRootPath(root);
@@ -141,6 +144,8 @@ void ExportInstanceDialog::doExport()
     }
 
     SaveIcon(m_instance);
+    // instance.cfg is part of the export, it has to be up to date on disk
+    SettingsObject::flushAll();
 
     auto files = QFileInfoList();
     if (!MMCZip::collectFileListRecursively(m_instance->instanceRoot(), nullptr, &files,
@@ -172,6 +177,16 @@ void ExportInstanceDialog::done(int result)
     QDialog::done(result);
 }
 
+void ExportInstanceDialog::updateSize()
+{
+    auto size = proxyModel->exportSize();
+    if (size < 0) {
+        ui->sizeLabel->setText(tr("Calculating size..."));
+    } else {
+        ui->sizeLabel->setText(tr("Export size: %1").arg(QLocale().formattedDataSize(size)));
+    }
+}
+
 void ExportInstanceDialog::rowsInserted(QModelIndex parent, int top, int bottom)
 {
     // WARNING: possible off-by-one?
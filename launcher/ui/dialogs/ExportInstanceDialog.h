@@ -72,4 +72,5 @@ class ExportInstanceDialog : public QDialog {
 
    private slots:
     void rowsInserted(QModelIndex parent, int top, int bottom);
+    void updateSize();
 };
@@ -6,6 +6,7 @@
 #include "ScrollMessageBox.h"
 #include "StringUtils.h"
 #include "minecraft/mod/tasks/GetModDependenciesTask.h"
+#include "minecraft/mod/tasks/ModUpdateCheckTask.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/flame/FlameAPI.h"
 #include "tasks/SequentialTask.h"
@@ -16,27 +17,14 @@
 #include "tasks/ConcurrentTask.h"
 
 #include "minecraft/MinecraftInstance.h"
-#include "minecraft/PackProfile.h"
 
 #include "modplatform/EnsureMetadataTask.h"
-#include "modplatform/flame/FlameCheckUpdate.h"
-#include "modplatform/modrinth/ModrinthCheckUpdate.h"
 
 #include <QTextBrowser>
 #include <QTreeWidgetItem>
 
 #include <optional>
 
-static std::list<Version> mcVersions(BaseInstance* inst)
-{
-    return { static_cast<MinecraftInstance*>(inst)->getPackProfile()->getComponent("net.minecraft")->getVersion() };
-}
-
-static QList<ModPlatform::ModLoaderType> mcLoadersList(BaseInstance* inst)
-{
-    return static_cast<MinecraftInstance*>(inst)->getPackProfile()->getModLoadersList();
-}
-
 ModUpdateDialog::ModUpdateDialog(QWidget* parent,
                                  BaseInstance* instance,
                                  const std::shared_ptr<ModFolderModel> mods,
@@ -86,24 +74,7 @@ void ModUpdateDialog::checkCandidates()
         }
     }
 
-    auto versions = mcVersions(m_instance);
-    auto loadersList = mcLoadersList(m_instance);
-
-    SequentialTask check_task(tr("Checking for updates"));
-
-    if (!m_modrinth_to_update.empty()) {
-        m_modrinth_check_task.reset(new ModrinthCheckUpdate(m_modrinth_to_update, versions, loadersList, m_mod_model));
-        connect(m_modrinth_check_task.get(), &CheckUpdateTask::checkFailed, this,
-                [this](Mod* mod, QString reason, QUrl recover_url) { m_failed_check_update.append({ mod, reason, recover_url }); });
-        check_task.addTask(m_modrinth_check_task);
-    }
-
-    if (!m_flame_to_update.empty()) {
-        m_flame_check_task.reset(new FlameCheckUpdate(m_flame_to_update, versions, loadersList, m_mod_model));
-        connect(m_flame_check_task.get(), &CheckUpdateTask::checkFailed, this,
-                [this](Mod* mod, QString reason, QUrl recover_url) { m_failed_check_update.append({ mod, reason, recover_url }); });
-        check_task.addTask(m_flame_check_task);
-    }
+    ModUpdateCheckTask check_task(static_cast<MinecraftInstance*>(m_instance), m_mod_model, m_modrinth_to_update + m_flame_to_update);
 
     connect(&check_task, &Task::failed, this,
             [&](QString reason) { CustomMessageBox::selectable(this, tr("Error"), reason, QMessageBox::Critical)->exec(); });
@@ -128,39 +99,21 @@ void ModUpdateDialog::checkCandidates()
         return;
     }
 
-    QList<std::shared_ptr<GetModDependenciesTask::PackDependency>> selectedVers;
+    for (auto& updatable : check_task.getUpdatable()) {
+        qDebug() << QString("Mod %1 has an update available!").arg(updatable.name);
 
-    // Add found updates for Modrinth
-    if (m_modrinth_check_task) {
-        auto modrinth_updates = m_modrinth_check_task->getUpdatable();
-        for (auto& updatable : modrinth_updates) {
-            qDebug() << QString("Mod %1 has an update available!").arg(updatable.name);
-
-            appendMod(updatable);
-            m_tasks.insert(updatable.name, updatable.download);
-        }
-        selectedVers.append(m_modrinth_check_task->getDependencies());
-    }
-
-    // Add found updated for Flame
-    if (m_flame_check_task) {
-        auto flame_updates = m_flame_check_task->getUpdatable();
-        for (auto& updatable : flame_updates) {
-            qDebug() << QString("Mod %1 has an update available!").arg(updatable.name);
-
-            appendMod(updatable);
-            m_tasks.insert(updatable.name, updatable.download);
-        }
-        selectedVers.append(m_flame_check_task->getDependencies());
+        appendMod(updatable);
+        m_tasks.insert(updatable.name, updatable.download);
     }
+    auto selectedVers = check_task.getDependencies();
 
     // Report failed update checking
-    if (!m_failed_check_update.empty()) {
+    if (!check_task.getFailed().empty()) {
         QString text;
-        for (const auto& failed : m_failed_check_update) {
-            const auto& mod = std::get<0>(failed);
-            const auto& reason = std::get<1>(failed);
-            const auto& recover_url = std::get<2>(failed);
+        for (const auto& failed : check_task.getFailed()) {
+            const auto& mod = failed.mod;
+            const auto& reason = failed.reason;
+            const auto& recover_url = failed.recover_url;
 
             qDebug() << mod->name() << " failed to check for updates!";
 
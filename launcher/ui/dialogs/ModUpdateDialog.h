@@ -9,8 +9,6 @@
 #include "modplatform/CheckUpdateTask.h"
 
 class Mod;
-class ModrinthCheckUpdate;
-class FlameCheckUpdate;
 class ConcurrentTask;
 
 class ModUpdateDialog final : public ReviewMessageBox {
@@ -45,9 +43,6 @@ class ModUpdateDialog final : public ReviewMessageBox {
    private:
     QWidget* m_parent;
 
-    shared_qobject_ptr<ModrinthCheckUpdate> m_modrinth_check_task;
-    shared_qobject_ptr<FlameCheckUpdate> m_flame_check_task;
-
     const std::shared_ptr<ModFolderModel> m_mod_model;
 
     QList<Mod*>& m_candidates;
@@ -56,7 +51,6 @@ class ModUpdateDialog final : public ReviewMessageBox {
 
     ConcurrentTask::Ptr m_second_try_metadata;
     QList<std::tuple<Mod*, QString>> m_failed_metadata;
-    QList<std::tuple<Mod*, QString, QUrl>> m_failed_check_update;
 
     QHash<QString, ResourceDownloadTask::Ptr> m_tasks;
     BaseInstance* m_instance;
@@ -47,6 +47,7 @@
 #include <QPersistentModelIndex>
 #include <QScrollBar>
 #include <QtMath>
+#include <algorithm>
 
 #include "VisualGroup.h"
 #include "ui/themes/ThemeManager.h"
@@ -71,7 +72,9 @@ InstanceView::InstanceView(QWidget* parent) : QAbstractItemView(parent)
     setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     setAcceptDrops(true);
     setAutoScroll(true);
-    setPaintCat(APPLICATION->settings()->get("TheCat").toBool());
+    if (APPLICATION_DYN) {
+        setPaintCat(APPLICATION->settings()->get("TheCat").toBool());
+    }
 }
 
 InstanceView::~InstanceView()
@@ -83,33 +86,48 @@ InstanceView::~InstanceView()
 void InstanceView::setModel(QAbstractItemModel* model)
 {
     QAbstractItemView::setModel(model);
+    m_layoutDirty = true;
     connect(model, &QAbstractItemModel::modelReset, this, &InstanceView::modelReset);
     connect(model, &QAbstractItemModel::rowsRemoved, this, &InstanceView::rowsRemoved);
+    // sorting moves rows around, which invalidates every cached position
+    connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this, [this] { m_layoutDirty = true; });
 }
 
-void InstanceView::dataChanged([[maybe_unused]] const QModelIndex& topLeft,
-                               [[maybe_unused]] const QModelIndex& bottomRight,
-                               [[maybe_unused]] const QVector<int>& roles)
+void InstanceView::dataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
 {
+    // progress and similar updates don't move anything, so just repaint the items
+    if (!roles.isEmpty() && !roles.contains(InstanceViewRoles::GroupRole) && !roles.contains(Qt::DisplayRole)) {
+        for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
+            viewport()->update(visualRect(model()->index(row, 0)));
+        }
+        return;
+    }
+    for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
+        m_dirtyRows.insert(row);
+    }
     scheduleDelayedItemsLayout();
 }
 void InstanceView::rowsInserted([[maybe_unused]] const QModelIndex& parent, [[maybe_unused]] int start, [[maybe_unused]] int end)
 {
+    m_layoutDirty = true;
     scheduleDelayedItemsLayout();
 }
 
 void InstanceView::rowsAboutToBeRemoved([[maybe_unused]] const QModelIndex& parent, [[maybe_unused]] int start, [[maybe_unused]] int end)
 {
+    m_layoutDirty = true;
     scheduleDelayedItemsLayout();
 }
 
 void InstanceView::modelReset()
 {
+    m_layoutDirty = true;
     scheduleDelayedItemsLayout();
 }
 
 void InstanceView::rowsRemoved()
 {
+    m_layoutDirty = true;
     scheduleDelayedItemsLayout();
 }
 
@@ -170,33 +188,59 @@ void InstanceView::updateScrollbar()
     verticalScrollBar()->setValue(qMin(previousScroll, verticalScrollBar()->maximum()));
 }
 
-void InstanceView::updateGeometries()
+void InstanceView::rebuildGroups()
 {
-    geometryCache.clear();
-
     QMap<LocaleString, VisualGroup*> cats;
 
+    m_rowGroups.resize(model()->rowCount());
     for (int i = 0; i < model()->rowCount(); ++i) {
-        const QString groupName = model()->index(i, 0).data(InstanceViewRoles::GroupRole).toString();
-        if (!cats.contains(groupName)) {
+        const QModelIndex index = model()->index(i, 0);
+        const QString groupName = index.data(InstanceViewRoles::GroupRole).toString();
+        auto& cat = cats[groupName];
+        if (!cat) {
             VisualGroup* old = this->category(groupName);
             if (old) {
-                auto cat = new VisualGroup(old);
-                cats.insert(groupName, cat);
-                cat->update();
+                cat = new VisualGroup(old);
             } else {
-                auto cat = new VisualGroup(groupName, this);
+                cat = new VisualGroup(groupName, this);
                 if (fVisibility) {
                     cat->collapsed = fVisibility(groupName);
                 }
-                cats.insert(groupName, cat);
-                cat->update();
             }
         }
+        cat->m_items.append(index);
+        m_rowGroups[i] = cat;
     }
 
     qDeleteAll(m_groups);
     m_groups = cats.values();
+}
+
+void InstanceView::updateGeometries()
+{
+    if (!m_layoutDirty && m_rowGroups.size() == model()->rowCount()) {
+        for (int row : m_dirtyRows) {
+            const QString groupName = model()->index(row, 0).data(InstanceViewRoles::GroupRole).toString();
+            if (m_rowGroups[row]->text != groupName) {
+                // moving between groups can create or remove groups, start over
+                m_layoutDirty = true;
+                break;
+            }
+            m_rowGroups[row]->dirty = true;
+        }
+    }
+    if (m_layoutDirty || m_rowGroups.size() != model()->rowCount()) {
+        rebuildGroups();
+    }
+    m_layoutDirty = false;
+    m_dirtyRows.clear();
+
+    for (auto group : m_groups) {
+        if (group->dirty) {
+            group->update();
+        }
+    }
+
     updateScrollbar();
     viewport()->update();
 }
@@ -213,6 +257,9 @@ bool InstanceView::isIndexHidden(const QModelIndex& index) const
 
 VisualGroup* InstanceView::category(const QModelIndex& index) const
 {
+    if (!m_layoutDirty && index.isValid() && index.row() < m_rowGroups.size()) {
+        return m_rowGroups[index.row()];
+    }
     return category(index.data(InstanceViewRoles::GroupRole).toString());
 }
 
@@ -250,6 +297,18 @@ QString InstanceView::groupNameAt(const QPoint& point)
     return QString();
 }
 
+QList<QModelIndex> InstanceView::indexesIn(const QRect& rect) const
+{
+    QList<QModelIndex> result;
+    // groups are laid out top to bottom, skip everything above the rect
+    auto group = std::lower_bound(m_groups.begin(), m_groups.end(), rect.top(),
+                                  [](VisualGroup* other, int y) { return other->verticalPosition() + other->totalHeight() <= y; });
+    for (; group != m_groups.end() && (*group)->verticalPosition() <= rect.bottom(); ++group) {
+        result += (*group)->itemsIn(rect);
+    }
+    return result;
+}
+
 int InstanceView::calculateItemsPerRow() const
 {
     return qFloor((qreal)(contentWidth()) / (qreal)(itemWidth() + m_spacing));
@@ -451,7 +510,7 @@ void InstanceView::setPaintCat(bool visible)
         m_catPixmap = QPixmap();
 }
 
-void InstanceView::paintEvent([[maybe_unused]] QPaintEvent* event)
+void InstanceView::paintEvent(QPaintEvent* event)
 {
     executeDelayedItemsLayout();
 
@@ -539,11 +598,7 @@ void InstanceView::paintEvent([[maybe_unused]] QPaintEvent* event)
         option.rect = backup;
     }
 
-    for (int i = 0; i < model()->rowCount(); ++i) {
-        const QModelIndex index = model()->index(i, 0);
-        if (isIndexHidden(index)) {
-            continue;
-        }
+    for (auto& index : indexesIn(event->rect().translated(offset()))) {
         Qt::ItemFlags flags = index.flags();
         option.rect = visualRect(index);
         option.features |= QStyleOptionViewItem::WrapText;
@@ -597,6 +652,9 @@ void InstanceView::resizeEvent([[maybe_unused]] QResizeEvent* event)
     if (newItemsPerRow != m_currentItemsPerRow) {
         m_currentCursorColumn = -1;
         m_currentItemsPerRow = newItemsPerRow;
+        for (auto group : m_groups) {
+            group->dirty = true;
+        }
         updateGeometries();
     } else {
         updateScrollbar();
@@ -722,50 +780,29 @@ QRect InstanceView::geometryRect(const QModelIndex& index) const
         return QRect();
     }
 
-    int row = index.row();
-    if (geometryCache.contains(row)) {
-        return *geometryCache[row];
-    }
-
     const VisualGroup* cat = category(index);
-    QPair<int, int> pos = cat->positionOf(index);
-    int x = pos.first;
-    // int y = pos.second;
-
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    QStyleOptionViewItem option;
-    initViewItemOption(&option);
-#else
-    QStyleOptionViewItem option = viewOptions();
-#endif
-
-    QRect out;
-    out.setTop(cat->verticalPosition() + cat->headerHeight() + 5 + cat->rowTopOf(index));
-    out.setLeft(m_spacing + x * (itemWidth() + m_spacing));
-    out.setSize(itemDelegate()->sizeHint(option, index));
-    geometryCache.insert(row, new QRect(out));
-    return out;
+    if (!cat) {
+        return QRect();
+    }
+    return cat->geometryOf(index);
 }
 
 QModelIndex InstanceView::indexAt(const QPoint& point) const
 {
     const_cast<InstanceView*>(this)->executeDelayedItemsLayout();
 
-    for (int i = 0; i < model()->rowCount(); ++i) {
-        QModelIndex index = model()->index(i, 0);
-        if (visualRect(index).contains(point)) {
-            return index;
-        }
+    auto indexes = indexesIn(QRect(point + offset(), QSize(1, 1)));
+    if (indexes.isEmpty()) {
+        return QModelIndex();
     }
-    return QModelIndex();
+    return indexes.first();
 }
 
 void InstanceView::setSelection(const QRect& rect, const QItemSelectionModel::SelectionFlags commands)
 {
     executeDelayedItemsLayout();
 
-    for (int i = 0; i < model()->rowCount(); ++i) {
-        QModelIndex index = model()->index(i, 0);
+    for (auto& index : indexesIn(rect.translated(offset()))) {
         QRect itemRect = visualRect(index);
         if (itemRect.intersects(rect)) {
             selectionModel()->select(index, commands);
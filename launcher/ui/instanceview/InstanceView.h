@@ -39,6 +39,8 @@
 #include <QLineEdit>
 #include <QListView>
 #include <QScrollBar>
+#include <QSet>
+#include <QVector>
 #include <functional>
 #include "VisualGroup.h"
 
@@ -127,7 +129,10 @@ class InstanceView : public QAbstractItemView {
     int m_itemWidth = 100;
     int m_currentItemsPerRow = -1;
     int m_currentCursorColumn = -1;
-    mutable QCache<int, QRect> geometryCache;
+    // the group of each model row, and the rows whose group or size may have changed since the last layout
+    QVector<VisualGroup*> m_rowGroups;
+    QSet<int> m_dirtyRows;
+    bool m_layoutDirty = true;
     bool m_catVisible = false;
     QPixmap m_catPixmap;
 
@@ -146,7 +151,12 @@ class InstanceView : public QAbstractItemView {
     int itemsPerRow() const { return m_currentItemsPerRow; };
     int contentWidth() const;
 
+    /// the visible items whose geometry intersects rect, in view coordinates
+    QList<QModelIndex> indexesIn(const QRect& rect) const;
+
    private: /* methods */
+    /// sort every model row into its group again
+    void rebuildGroups();
     int itemWidth() const;
     int calculateItemsPerRow() const;
     int verticalScrollToValue(const QModelIndex& index, const QRect& rect, QListView::ScrollHint hint) const;
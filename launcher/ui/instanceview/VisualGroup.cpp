@@ -41,6 +41,7 @@
 #include <QModelIndex>
 #include <QPainter>
 #include <QtMath>
+#include <algorithm>
 #include <utility>
 
 #include "InstanceView.h"
@@ -51,17 +52,27 @@ VisualGroup::VisualGroup(const VisualGroup* other) : view(other->view), text(oth
 
 void VisualGroup::update()
 {
-    auto temp_items = items();
     auto itemsPerRow = view->itemsPerRow();
 
-    int numRows = qMax(1, qCeil((qreal)temp_items.size() / (qreal)itemsPerRow));
+    int numRows = qMax(1, qCeil((qreal)m_items.size() / (qreal)itemsPerRow));
     rows = QVector<VisualRow>(numRows);
+    m_positions.clear();
+    m_geometries.clear();
 
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QStyleOptionViewItem viewItemOption;
+    view->initViewItemOption(&viewItemOption);
+#else
+    QStyleOptionViewItem viewItemOption = view->viewOptions();
+#endif
+
+    QVector<QSize> sizes;
+    sizes.reserve(m_items.size());
     int maxRowHeight = 0;
     int positionInRow = 0;
     int currentRow = 0;
     int offsetFromTop = 0;
-    for (auto item : temp_items) {
+    for (auto& item : m_items) {
         if (positionInRow == itemsPerRow) {
             rows[currentRow].height = maxRowHeight;
             rows[currentRow].top = offsetFromTop;
@@ -73,39 +84,70 @@ void VisualGroup::update()
             positionInRow = 0;
             maxRowHeight = 0;
         }
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        QStyleOptionViewItem viewItemOption;
-        view->initViewItemOption(&viewItemOption);
-#else
-        QStyleOptionViewItem viewItemOption = view->viewOptions();
-#endif
 
-        auto itemHeight = view->itemDelegate()->sizeHint(viewItemOption, item).height();
-        if (itemHeight > maxRowHeight) {
-            maxRowHeight = itemHeight;
+        auto size = view->itemDelegate()->sizeHint(viewItemOption, item);
+        if (size.height() > maxRowHeight) {
+            maxRowHeight = size.height();
         }
+        sizes.append(size);
+        m_positions.insert(item.row(), qMakePair(rows[currentRow].items.size(), currentRow));
         rows[currentRow].items.append(item);
         positionInRow++;
     }
     rows[currentRow].height = maxRowHeight;
     rows[currentRow].top = offsetFromTop;
+
+    const int bodyTop = headerHeight() + 5;
+    for (int i = 0; i < m_items.size(); i++) {
+        auto position = m_positions.value(m_items[i].row());
+        QRect out;
+        out.setTop(bodyTop + rows[position.second].top);
+        out.setLeft(view->m_spacing + position.first * (view->itemWidth() + view->m_spacing));
+        out.setSize(sizes[i]);
+        m_geometries.insert(m_items[i].row(), out);
+    }
+    dirty = false;
 }
 
 QPair<int, int> VisualGroup::positionOf(const QModelIndex& index) const
 {
-    int y = 0;
-    for (auto& row : rows) {
-        for (auto x = 0; x < row.items.size(); x++) {
-            if (row.items[x] == index) {
-                return qMakePair(x, y);
-            }
-        }
-        y++;
+    auto iter = m_positions.find(index.row());
+    if (iter != m_positions.end()) {
+        return *iter;
     }
     qWarning() << "Item" << index.row() << index.data(Qt::DisplayRole).toString() << "not found in visual group" << text;
     return qMakePair(0, 0);
 }
 
+QRect VisualGroup::geometryOf(const QModelIndex& index) const
+{
+    auto iter = m_geometries.find(index.row());
+    if (iter == m_geometries.end()) {
+        return QRect();
+    }
+    return iter->translated(0, verticalPosition());
+}
+
+QList<QModelIndex> VisualGroup::itemsIn(const QRect& rect) const
+{
+    QList<QModelIndex> result;
+    if (collapsed) {
+        return result;
+    }
+    const int bodyTop = verticalPosition() + headerHeight() + 5;
+    // rows are sorted top to bottom, skip everything above the rect
+    auto row = std::lower_bound(rows.begin(), rows.end(), rect.top() - bodyTop,
+                                [](const VisualRow& other, int y) { return other.top + other.height <= y; });
+    for (; row != rows.end() && bodyTop + row->top <= rect.bottom(); ++row) {
+        for (auto& item : row->items) {
+            if (geometryOf(item).intersects(rect)) {
+                result.append(item);
+            }
+        }
+    }
+    return result;
+}
+
 int VisualGroup::rowTopOf(const QModelIndex& index) const
 {
     auto position = positionOf(index);
@@ -258,12 +300,5 @@ int VisualGroup::verticalPosition() const
 
 QList<QModelIndex> VisualGroup::items() const
 {
-    QList<QModelIndex> indices;
-    for (int i = 0; i < view->model()->rowCount(); ++i) {
-        const QModelIndex index = view->model()->index(i, 0);
-        if (index.data(InstanceViewRoles::GroupRole).toString() == text) {
-            indices.append(index);
-        }
-    }
-    return indices;
+    return m_items;
 }
@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <QHash>
+#include <QModelIndex>
 #include <QRect>
 #include <QString>
 #include <QStyleOption>
@@ -42,7 +44,6 @@
 
 class InstanceView;
 class QPainter;
-class QModelIndex;
 
 struct VisualRow {
     QList<QModelIndex> items;
@@ -64,9 +65,13 @@ struct VisualGroup {
     QVector<VisualRow> rows;
     int firstItemIndex = 0;
     int m_verticalPosition = 0;
+    /// the items of this group, in model order. filled in by the view.
+    QList<QModelIndex> m_items;
+    /// set when the items or their sizes changed and the rows need to be flowed again
+    bool dirty = true;
 
     /* logic */
-    /// update the internal list of items and flow them into the rows.
+    /// flow the items into the rows and cache their positions.
     void update();
 
     /// draw the header at y-position.
@@ -99,6 +104,12 @@ struct VisualGroup {
     /// x/y position of the given item inside the group (in items!)
     QPair<int, int> positionOf(const QModelIndex& index) const;
 
+    /// geometry rectangle of the given item, in view coordinates
+    QRect geometryOf(const QModelIndex& index) const;
+
+    /// the items whose geometry intersects rect, in view coordinates
+    QList<QModelIndex> itemsIn(const QRect& rect) const;
+
     enum HitResult { NoHit = 0x0, TextHit = 0x1, CheckboxHit = 0x2, HeaderHit = 0x4, BodyHit = 0x8 };
     Q_DECLARE_FLAGS(HitResults, HitResult)
 
@@ -106,6 +117,11 @@ struct VisualGroup {
     HitResults hitScan(const QPoint& pos) const;
 
     QList<QModelIndex> items() const;
+
+   private:
+    /// position and geometry of each item relative to the group, by model row
+    QHash<int, QPair<int, int>> m_positions;
+    QHash<int, QRect> m_geometries;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(VisualGroup::HitResults)
@@ -82,10 +82,19 @@ InstanceSettingsPage::InstanceSettingsPage(BaseInstance* inst, QWidget* parent)
     m_world_quickplay_supported = mInst && mInst->traits().contains("feature:is_quick_play_singleplayer");
     if (m_world_quickplay_supported) {
         auto worlds = mInst->worldList();
+        // the scan runs in the background, only list the worlds once it knows which folders are real ones
+        connect(worlds.get(), &WorldList::scanFinished, this, [this, list = worlds.get()] {
+            auto selected = ui->worldsCb->currentText();
+            if (selected.isEmpty())
+                selected = m_settings->get("JoinWorldOnLaunch").toString();
+            ui->worldsCb->clear();
+            for (const auto& world : list->allWorlds()) {
+                if (world.isValid())
+                    ui->worldsCb->addItem(world.folderName());
+            }
+            ui->worldsCb->setCurrentText(selected);
+        });
         worlds->update();
-        for (const auto& world : worlds->allWorlds()) {
-            ui->worldsCb->addItem(world.folderName());
-        }
     } else {
         ui->worldsCb->hide();
         ui->worldJoinButton->hide();
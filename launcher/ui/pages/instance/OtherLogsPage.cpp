@@ -160,8 +160,23 @@ void OtherLogsPage::on_btnReload_clicked()
         }
         QString content;
         if (file.fileName().endsWith(".gz")) {
+            // inflate no more than what could be shown, so a small archive of a huge log does not balloon in memory
+            static const qint64 maxSize = 50000000ll;
+            GZipDevice gzip(&file);
             QByteArray temp;
-            if (!GZip::unzip(file.readAll(), temp)) {
+            if (gzip.open(QIODevice::ReadOnly)) {
+                while (!gzip.atEnd() && temp.size() <= maxSize) {
+                    auto chunk = gzip.read(64 * 1024);
+                    if (chunk.isEmpty())
+                        break;
+                    temp.append(chunk);
+                }
+            }
+            if (temp.size() > maxSize) {
+                showTooBig();
+                return;
+            }
+            if (!gzip.atEnd()) {
                 setPlainText(tr("The file (%1) is not readable.").arg(file.fileName()));
                 return;
             }
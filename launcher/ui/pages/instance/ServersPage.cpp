@@ -40,14 +40,17 @@
 #include "ui_ServersPage.h"
 
 #include <FileSystem.h>
-#include <io/stream_reader.h>
+#include <io/stream_writer.h>
 #include <minecraft/MinecraftInstance.h>
+#include <minecraft/NbtReader.h>
 #include <tag_compound.h>
 #include <tag_list.h>
 #include <tag_primitive.h>
 #include <tag_string.h>
+#include <optional>
 #include <sstream>
 
+#include <QFile>
 #include <QFileSystemWatcher>
 #include <QMenu>
 #include <QTimer>
@@ -65,21 +68,18 @@ struct Server {
         m_name = name;
         m_address = address;
     }
-    Server(nbt::tag_compound& server)
+    Server(const QVariantMap& server)
     {
-        std::string addressStr(server["ip"]);
-        m_address = QString::fromUtf8(addressStr.c_str());
+        m_address = server.value("ip").toString();
+        m_name = server.value("name").toString();
 
-        std::string nameStr(server["name"]);
-        m_name = QString::fromUtf8(nameStr.c_str());
-
-        if (server["icon"]) {
-            std::string base64str(server["icon"]);
-            m_icon = QByteArray::fromBase64(base64str.c_str());
+        if (server.contains("icon")) {
+            m_icon = QByteArray::fromBase64(server.value("icon").toString().toUtf8());
         }
 
-        if (server.has_key("acceptTextures", nbt::tag_type::Byte)) {
-            bool value = server["acceptTextures"].as<nbt::tag_byte>().get();
+        auto acceptTextures = server.value("acceptTextures");
+        if (acceptTextures.userType() == qMetaTypeId<qint8>()) {
+            bool value = acceptTextures.value<qint8>();
             if (value) {
                 m_acceptsTextures = AcceptsTextures::ALWAYS;
             } else {
@@ -117,23 +117,17 @@ struct Server {
     int m_maxPlayers = 0;
 };
 
-static std::unique_ptr<nbt::tag_compound> parseServersDat(const QString& filename)
+static std::optional<QVariantList> parseServersDat(const QString& filename)
 {
-    try {
-        QByteArray input = FS::read(filename);
-        std::istringstream foo(std::string(input.constData(), input.size()));
-        auto pair = nbt::io::read_compound(foo);
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
 
-        if (pair.first != "")
-            return nullptr;
+    NbtReader reader({ "servers" });
+    if (!reader.read(&file) || !reader.rootName().isEmpty())
+        return std::nullopt;
 
-        if (pair.second == nullptr)
-            return nullptr;
-
-        return std::move(pair.second);
-    } catch (...) {
-        return nullptr;
-    }
+    return reader.value("servers").toList();
 }
 
 static bool serializeServerDat(const QString& filename, nbt::tag_compound* levelInfo)
@@ -414,10 +408,8 @@ class ServersModel : public QAbstractListModel {
         QList<Server> servers;
         auto serversDat = parseServersDat(serversPath());
         if (serversDat) {
-            auto& serversList = serversDat->at("servers").as<nbt::tag_list>();
-            for (auto iter = serversList.begin(); iter != serversList.end(); iter++) {
-                auto& serverTag = (*iter).as<nbt::tag_compound>();
-                Server s(serverTag);
+            for (auto& serverTag : *serversDat) {
+                Server s(serverTag.toMap());
                 servers.append(s);
             }
         }
@@ -5,18 +5,23 @@
 #include "ResourceModel.h"
 
 #include <QCryptographicHash>
+#include <QFileInfo>
+#include <QFutureWatcher>
 #include <QIcon>
 #include <QList>
 #include <QMessageBox>
-#include <QPixmapCache>
 #include <QUrl>
+#include <QtConcurrentRun>
 #include <algorithm>
 #include <memory>
 
 #include "Application.h"
 #include "BuildConfig.h"
+#include "FileSystem.h"
 #include "Json.h"
 
+#include "icons/IconCache.h"
+
 #include "net/ApiDownload.h"
 #include "net/NetJob.h"
 
@@ -24,13 +29,25 @@
 
 #include "ui/widgets/ProjectItem.h"
 
+namespace {
+// the size the project list draws icons at
+const QSize ICON_SIZE(64, 64);
+const int ICON_CACHE_BYTES = 16 * 1024 * 1024;
+// prefetching shouldn't hold up the icons that are on screen
+const int ICON_PREFETCH_CONCURRENCY = 2;
+}  // namespace
+
 namespace ResourceDownload {
 
 QHash<ResourceModel*, bool> ResourceModel::s_running_models;
 
-ResourceModel::ResourceModel(ResourceAPI* api) : QAbstractListModel(), m_api(api)
+ResourceModel::ResourceModel(ResourceAPI* api) : QAbstractListModel(), m_api(api), m_icon_cache(new IconCache(ICON_CACHE_BYTES, this))
 {
     s_running_models.insert(this, true);
+    connect(m_icon_cache, &IconCache::loaded, this, [this](const QString& path) {
+        if (auto url = m_icon_urls.constFind(path); url != m_icon_urls.constEnd())
+            iconChanged(*url);
+    });
     if (APPLICATION_DYN) {
         m_current_info_job.setMaxConcurrent(APPLICATION->settings()->get("NumberOfConcurrentDownloads").toInt());
     }
@@ -61,8 +78,7 @@ auto ResourceModel::data(const QModelIndex& index, int role) const -> QVariant
         }
         case Qt::DecorationRole: {
             if (APPLICATION_DYN) {
-                if (auto icon_or_none = const_cast<ResourceModel*>(this)->getIcon(const_cast<QModelIndex&>(index), pack->logoUrl);
-                    icon_or_none.has_value())
+                if (auto icon_or_none = const_cast<ResourceModel*>(this)->getIcon(pack->logoUrl); icon_or_none.has_value())
                     return icon_or_none.value();
 
                 return APPLICATION->getThemedIcon("screenshot-placeholder");
@@ -279,6 +295,10 @@ void ResourceModel::refresh()
 
 void ResourceModel::clearData()
 {
+    if (m_prefetch_icon_job)
+        m_prefetch_icon_job->abort();
+    m_prefetching_icons.clear();
+
     beginResetModel();
     m_packs.clear();
     endResetModel();
@@ -315,37 +335,46 @@ std::optional<ResourceAPI::SortingMethod> ResourceModel::getCurrentSortingMethod
     return sort;
 }
 
-std::optional<QIcon> ResourceModel::getIcon(QModelIndex& index, const QUrl& url)
+MetaEntryPtr ResourceModel::iconEntry(const QUrl& url) const
 {
-    QPixmap pixmap;
-    if (QPixmapCache::find(url.toString(), &pixmap))
-        return { pixmap };
+    return APPLICATION->metacache()->resolveEntry(
+        metaEntryBase(),
+        QString("logos/%1").arg(QString(QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Algorithm::Sha1).toHex())));
+}
 
-    if (!m_current_icon_job) {
-        m_current_icon_job.reset(new NetJob("IconJob", APPLICATION->network()));
-        m_current_icon_job->setAskRetry(false);
+std::optional<QIcon> ResourceModel::getIcon(const QUrl& url)
+{
+    if (auto file = m_icon_files.constFind(url); file != m_icon_files.constEnd()) {
+        // decoded in the background, the rows are updated once it is done
+        auto pixmap = m_icon_cache->request(*file, ICON_SIZE);
+        if (pixmap.isNull())
+            return {};
+        return QIcon(pixmap);
     }
 
-    if (m_currently_running_icon_actions.contains(url))
+    if (m_currently_running_icon_actions.contains(url) || m_prefetching_icons.contains(url))
         return {};
     if (m_failed_icon_actions.contains(url))
         return {};
 
-    auto cache_entry = APPLICATION->metacache()->resolveEntry(
-        metaEntryBase(),
-        QString("logos/%1").arg(QString(QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Algorithm::Sha1).toHex())));
-    auto icon_fetch_action = Net::ApiDownload::makeCached(url, cache_entry);
+    auto cache_entry = iconEntry(url);
+    if (!cache_entry->isStale()) {
+        prepareIcon(url, cache_entry);
+        return {};
+    }
 
-    auto full_file_path = cache_entry->getFullPath();
-    connect(icon_fetch_action.get(), &Task::succeeded, this, [=] {
-        auto icon = QIcon(full_file_path);
-        QPixmapCache::insert(url.toString(), icon.pixmap(icon.actualSize({ 64, 64 })));
+    if (!m_current_icon_job) {
+        m_current_icon_job.reset(new NetJob("IconJob", APPLICATION->network()));
+        m_current_icon_job->setAskRetry(false);
+    }
 
-        m_currently_running_icon_actions.remove(url);
+    auto icon_fetch_action = Net::ApiDownload::makeCached(url, cache_entry);
 
-        emit dataChanged(index, index, { Qt::DecorationRole });
+    connect(icon_fetch_action.get(), &Task::succeeded, this, [this, url, cache_entry] {
+        m_currently_running_icon_actions.remove(url);
+        prepareIcon(url, cache_entry);
     });
-    connect(icon_fetch_action.get(), &Task::failed, this, [=] {
+    connect(icon_fetch_action.get(), &Task::failed, this, [this, url] {
         m_currently_running_icon_actions.remove(url);
         m_failed_icon_actions.insert(url);
     });
@@ -359,6 +388,94 @@ std::optional<QIcon> ResourceModel::getIcon(QModelIndex& index, const QUrl& url)
     return {};
 }
 
+void ResourceModel::prefetchIcons(const QList<ModPlatform::IndexedPack::Ptr>& packs)
+{
+    if (!APPLICATION_DYN)
+        return;
+
+    if (!m_prefetch_icon_job || !m_prefetch_icon_job->isRunning()) {
+        m_prefetch_icon_job.reset(new NetJob("IconPrefetchJob", APPLICATION->network(), ICON_PREFETCH_CONCURRENCY));
+        m_prefetch_icon_job->setAskRetry(false);
+    }
+
+    for (auto const& pack : packs) {
+        auto url = pack->logoUrl;
+        if (url.isEmpty() || m_icon_files.contains(url) || m_currently_running_icon_actions.contains(url) ||
+            m_failed_icon_actions.contains(url) || m_prefetching_icons.contains(url))
+            continue;
+
+        // icons already on disk are left for getIcon to pick up once the row is shown
+        auto cache_entry = iconEntry(url);
+        if (!cache_entry->isStale())
+            continue;
+
+        auto icon_fetch_action = Net::ApiDownload::makeCached(url, cache_entry);
+        connect(icon_fetch_action.get(), &Task::succeeded, this, [this, url, cache_entry] {
+            m_prefetching_icons.remove(url);
+            prepareIcon(url, cache_entry);
+        });
+        // getIcon skips icons being prefetched, so have the rows ask again and go through the regular download
+        connect(icon_fetch_action.get(), &Task::failed, this, [this, url] {
+            m_prefetching_icons.remove(url);
+            iconChanged(url);
+        });
+        connect(icon_fetch_action.get(), &Task::aborted, this, [this, url] { m_prefetching_icons.remove(url); });
+
+        m_prefetching_icons.insert(url);
+        m_prefetch_icon_job->addNetAction(icon_fetch_action);
+    }
+
+    if (m_prefetch_icon_job->size() > 0 && !m_prefetch_icon_job->isRunning())
+        QMetaObject::invokeMethod(m_prefetch_icon_job.get(), &NetJob::start);
+}
+
+void ResourceModel::prepareIcon(const QUrl& url, const MetaEntryPtr& entry)
+{
+    // logos are usually far bigger than we draw them, so keep a downscaled copy around for next time
+    auto key = QCryptographicHash::hash(url.toEncoded() + entry->getETag().toUtf8(), QCryptographicHash::Algorithm::Sha1).toHex();
+    auto thumbnail = FS::PathCombine(APPLICATION->metacache()->getBasePath(metaEntryBase()), "logos", "thumbnails", QString(key) + ".png");
+    if (QFileInfo::exists(thumbnail)) {
+        iconReady(url, thumbnail);
+        return;
+    }
+
+    m_currently_running_icon_actions.insert(url);
+
+    auto watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, url] {
+        m_currently_running_icon_actions.remove(url);
+        auto file = watcher->result();
+        if (file.isEmpty())
+            m_failed_icon_actions.insert(url);
+        else
+            iconReady(url, file);
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([source = entry->getFullPath(), thumbnail] {
+        auto image = IconCache::load(source, ICON_SIZE);
+        if (image.isNull())
+            return QString();
+        if (FS::ensureFilePathExists(thumbnail) && image.save(thumbnail, "PNG"))
+            return thumbnail;
+        return source;
+    }));
+}
+
+void ResourceModel::iconReady(const QUrl& url, const QString& file)
+{
+    m_icon_files.insert(url, file);
+    m_icon_urls.insert(file, url);
+    iconChanged(url);
+}
+
+void ResourceModel::iconChanged(const QUrl& url)
+{
+    for (int row = 0; row < m_packs.size(); row++) {
+        if (m_packs.at(row)->logoUrl == url)
+            emit dataChanged(index(row), index(row), { Qt::DecorationRole });
+    }
+}
+
 // No 'forgor to implement' shall pass here :blobfox_knife:
 #define NEED_FOR_CALLBACK_ASSERT(name) \
     Q_ASSERT_X(0 != 0, #name, "You NEED to re-implement this if you intend on using the default callbacks.")
@@ -428,6 +545,8 @@ void ResourceModel::searchRequestSucceeded(QJsonDocument& doc)
     beginInsertRows(QModelIndex(), m_packs.size(), m_packs.size() + filteredNewList.size() - 1);
     m_packs.append(filteredNewList);
     endInsertRows();
+
+    prefetchIcons(filteredNewList);
 }
 
 void ResourceModel::searchRequestForOneSucceeded(QJsonDocument& doc)
@@ -9,6 +9,7 @@
 #include <QAbstractListModel>
 
 #include "QObjectPtr.h"
+#include "net/HttpMetaCache.h"
 
 #include "ResourceDownloadTask.h"
 #include "modplatform/ModIndex.h"
@@ -16,6 +17,7 @@
 
 #include "tasks/ConcurrentTask.h"
 
+class IconCache;
 class NetJob;
 class ResourceAPI;
 
@@ -95,8 +97,8 @@ class ResourceModel : public QAbstractListModel {
     /** Schedule a refresh, clearing the current state. */
     void refresh();
 
-    /** Gets the icon at the URL for the given index. If it's not fetched yet, fetch it and update when fisinhed. */
-    std::optional<QIcon> getIcon(QModelIndex&, const QUrl&);
+    /** Gets the icon at the URL. If it's not fetched or decoded yet, do so and update the rows using it when finished. */
+    std::optional<QIcon> getIcon(const QUrl&);
 
     void addPack(ModPlatform::IndexedPack::Ptr pack,
                  ModPlatform::IndexedVersion& version,
@@ -147,9 +149,16 @@ class ResourceModel : public QAbstractListModel {
     // Job for fetching versions and extra info on existing entries
     ConcurrentTask m_current_info_job;
 
+    IconCache* m_icon_cache;
     shared_qobject_ptr<NetJob> m_current_icon_job;
     QSet<QUrl> m_currently_running_icon_actions;
     QSet<QUrl> m_failed_icon_actions;
+    // Job for downloading the icons of rows that were loaded but not shown yet
+    shared_qobject_ptr<NetJob> m_prefetch_icon_job;
+    QSet<QUrl> m_prefetching_icons;
+    // downscaled copies of the icons, ready to be decoded
+    QHash<QUrl, QString> m_icon_files;
+    QHash<QString, QUrl> m_icon_urls;
 
     QList<ModPlatform::IndexedPack::Ptr> m_packs;
     QList<DownloadTaskPtr> m_selected;
@@ -159,6 +168,12 @@ class ResourceModel : public QAbstractListModel {
     static QHash<ResourceModel*, bool> s_running_models;
 
    private:
+    [[nodiscard]] MetaEntryPtr iconEntry(const QUrl&) const;
+    void prefetchIcons(const QList<ModPlatform::IndexedPack::Ptr>&);
+    void prepareIcon(const QUrl&, const MetaEntryPtr&);
+    void iconReady(const QUrl&, const QString& file);
+    void iconChanged(const QUrl&);
+
     /* Default search request callbacks */
     void searchRequestSucceeded(QJsonDocument&);
     void searchRequestForOneSucceeded(QJsonDocument&);
@@ -0,0 +1,101 @@
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <FileWatcher.h>
+
+static void writeFile(const QString& path, const QByteArray& data)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(data);
+}
+
+class FileWatcherTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void initTestCase() { qRegisterMetaType<QList<FileWatcher::Change>>(); }
+
+    void test_coalescedDeltas()
+    {
+        QTemporaryDir tmp;
+        auto modified = FS::PathCombine(tmp.path(), "modified.txt");
+        auto created = FS::PathCombine(tmp.path(), "created.txt");
+        auto transient = FS::PathCombine(tmp.path(), "transient.txt");
+        writeFile(modified, "old");
+
+        FileWatcher watcher;
+        QVERIFY(watcher.addPath(tmp.path()));
+        QCOMPARE(watcher.directories(), QStringList{ tmp.path() });
+        QSignalSpy changedSpy(&watcher, &FileWatcher::changed);
+        QSignalSpy directorySpy(&watcher, &FileWatcher::directoryChanged);
+
+        writeFile(created, "new");
+        writeFile(transient, "gone soon");
+        QVERIFY(QFile::remove(transient));
+        // replaced, as saving through a temporary file does
+        QVERIFY(QFile::remove(modified));
+        writeFile(modified, "new contents");
+
+        QVERIFY(changedSpy.wait());
+        QTest::qWait(300);
+
+        // everything above happened inside one window, so it's reported once
+        QCOMPARE(changedSpy.count(), 1);
+        QCOMPARE(directorySpy.count(), 1);
+        QCOMPARE(changedSpy[0][0].toString(), tmp.path());
+
+        auto changes = changedSpy[0][1].value<QList<FileWatcher::Change>>();
+        QCOMPARE(changes.size(), 2);
+        QVERIFY(changes.contains(FileWatcher::Change{ FileWatcher::Change::Created, created }));
+        QVERIFY(changes.contains(FileWatcher::Change{ FileWatcher::Change::Modified, modified }));
+    }
+
+#ifdef Q_OS_LINUX
+    void test_directoryIgnoresWrites()
+    {
+        QTemporaryDir tmp;
+        auto file = FS::PathCombine(tmp.path(), "file.txt");
+        writeFile(file, "old");
+
+        FileWatcher watcher;
+        QVERIFY(watcher.addPath(tmp.path()));
+        QSignalSpy changedSpy(&watcher, &FileWatcher::changed);
+
+        // writing to a file doesn't change the entries of its directory
+        writeFile(file, "new contents");
+        QVERIFY(!changedSpy.wait(300));
+    }
+#endif
+
+    void test_sharedPath()
+    {
+        QTemporaryDir tmp;
+
+        FileWatcher first;
+        FileWatcher second;
+        QVERIFY(first.addPath(tmp.path()));
+        QVERIFY(second.addPath(tmp.path()));
+        QSignalSpy firstSpy(&first, &FileWatcher::directoryChanged);
+        QSignalSpy secondSpy(&second, &FileWatcher::directoryChanged);
+
+        writeFile(FS::PathCombine(tmp.path(), "a.txt"), "a");
+        QVERIFY(firstSpy.wait());
+        QTRY_COMPARE(secondSpy.count(), 1);
+
+        // dropping one watcher keeps the other one going
+        QVERIFY(first.removePath(tmp.path()));
+        QVERIFY(first.directories().isEmpty());
+        writeFile(FS::PathCombine(tmp.path(), "b.txt"), "b");
+        QVERIFY(secondSpy.wait());
+        QCOMPARE(firstSpy.count(), 1);
+        QCOMPARE(secondSpy.count(), 2);
+    }
+};
+
+QTEST_GUILESS_MAIN(FileWatcherTest)
+
+#include "FileWatcher_test.moc"
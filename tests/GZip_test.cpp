@@ -1,3 +1,4 @@
+#include <QBuffer>
 #include <QTest>
 
 #include <GZip.h>
@@ -45,6 +46,114 @@ class GZipTest : public QObject {
             fib(prev, cur);
         } while (cur < size);
     }
+
+    void test_StreamThrough()
+    {
+        static const int size = 4 * 1024 * 1024;
+        QByteArray random = compressibleData(size);
+
+        int prev = 1;
+        int cur = 1;
+        do {
+            QByteArray copy = random.left(cur);
+
+            QByteArray compressed;
+            QBuffer compressedBuffer(&compressed);
+            GZipDevice writer(&compressedBuffer);
+            QVERIFY(writer.open(QIODevice::WriteOnly));
+            // odd sized writes, to cross the internal buffer boundaries
+            for (int offset = 0; offset < copy.size(); offset += 7777) {
+                qint64 length = qMin(7777, copy.size() - offset);
+                QCOMPARE(writer.write(copy.constData() + offset, length), length);
+            }
+            QVERIFY(writer.finish());
+            writer.close();
+            compressedBuffer.close();
+
+            // the streamed output is a regular gzip stream
+            QByteArray decompressed;
+            QVERIFY(GZip::unzip(compressed, decompressed));
+            QCOMPARE(decompressed, copy);
+
+            compressedBuffer.open(QIODevice::ReadOnly);
+            GZipDevice reader(&compressedBuffer);
+            QVERIFY(reader.open(QIODevice::ReadOnly));
+            QCOMPARE(reader.readAll(), copy);
+            QVERIFY(reader.atEnd());
+
+            fib(prev, cur);
+        } while (cur < size);
+    }
+
+    void test_StreamTruncated()
+    {
+        QByteArray compressed;
+        QVERIFY(GZip::zip(compressibleData(1024 * 1024), compressed));
+        compressed.chop(compressed.size() / 2);
+
+        QBuffer buffer(&compressed);
+        GZipDevice reader(&buffer);
+        QVERIFY(reader.open(QIODevice::ReadOnly));
+        reader.readAll();
+        QVERIFY(!reader.atEnd());
+        QVERIFY(!reader.errorString().isEmpty());
+    }
+
+    void benchmark_Unzip()
+    {
+        QByteArray compressed;
+        QVERIFY(GZip::zip(compressibleData(32 * 1024 * 1024), compressed));
+        QBENCHMARK
+        {
+            QByteArray decompressed;
+            QVERIFY(GZip::unzip(compressed, decompressed));
+        }
+    }
+
+    void benchmark_StreamInflate()
+    {
+        QByteArray compressed;
+        QVERIFY(GZip::zip(compressibleData(32 * 1024 * 1024), compressed));
+        QBENCHMARK
+        {
+            QBuffer buffer(&compressed);
+            GZipDevice reader(&buffer);
+            QVERIFY(reader.open(QIODevice::ReadOnly));
+            char chunk[64 * 1024];
+            while (reader.read(chunk, sizeof(chunk)) > 0) {
+            }
+            QVERIFY(reader.atEnd());
+        }
+    }
+
+    void benchmark_StreamDeflate()
+    {
+        QByteArray data = compressibleData(32 * 1024 * 1024);
+        QBENCHMARK
+        {
+            QByteArray compressed;
+            QBuffer buffer(&compressed);
+            GZipDevice writer(&buffer);
+            QVERIFY(writer.open(QIODevice::WriteOnly));
+            QCOMPARE(writer.write(data), qint64(data.size()));
+            QVERIFY(writer.finish());
+        }
+    }
+
+   private:
+    // log-like text, which compresses about as well as what the launcher actually deals with
+    static QByteArray compressibleData(int size)
+    {
+        std::default_random_engine eng(42);
+        std::uniform_int_distribution<int> idis(0, 9999);
+        QByteArray data;
+        data.reserve(size);
+        while (data.size() < size) {
+            data.append(QString("[12:34:56] [Render thread/INFO]: Loaded %1 entries\n").arg(idis(eng)).toUtf8());
+        }
+        data.resize(size);
+        return data;
+    }
 };
 
 QTEST_GUILESS_MAIN(GZipTest)
@@ -1,8 +1,11 @@
 #include <QTest>
 
 #include <settings/INIFile.h>
+#include <settings/INISettingsObject.h>
+#include <QFileInfo>
 #include <QList>
 #include <QSettings>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QVariant>
 #include "FileSystem.h"
@@ -190,6 +193,55 @@ PreLaunchCommand=)";
         FS::deletePath(fileName);
 #endif
     }
+
+    void test_SettingsObjectCoalescesSaves()
+    {
+        QTemporaryDir dir;
+        QString fileName = dir.filePath("coalesced.cfg");
+
+        INISettingsObject settings(fileName);
+        settings.registerSetting("Value", 0);
+        for (int i = 1; i <= 100; i++) {
+            settings.set("Value", i);
+        }
+        // nothing is written until the save timer fires
+        QVERIFY(!QFileInfo::exists(fileName));
+
+        SettingsObject::flushAll();
+        INIFile f1;
+        QVERIFY(f1.loadFile(fileName));
+        QCOMPARE(f1.get("Value", "NOT SET").toInt(), 100);
+
+        // and the timer alone gets it there as well
+        settings.set("Value", 101);
+        auto savedValue = [&fileName]() {
+            INIFile f2;
+            f2.loadFile(fileName);
+            return f2.get("Value", "NOT SET").toInt();
+        };
+        QTRY_COMPARE(savedValue(), 101);
+    }
+
+    void test_SettingsObjectDiscardChanges()
+    {
+        QTemporaryDir dir;
+        QString folder = dir.filePath("instance");
+        QString fileName = FS::PathCombine(folder, "instance.cfg");
+        QVERIFY(FS::ensureFolderPathExists(folder));
+
+        {
+            INISettingsObject settings(fileName);
+            settings.registerSetting("Value", 0);
+            settings.set("Value", 1);
+
+            // the instance gets deleted while the change still waits for the save timer
+            settings.discardChanges();
+            QVERIFY(FS::deletePath(folder));
+            settings.set("Value", 2);
+        }
+        QTest::qWait(100);
+        QVERIFY(!QFileInfo::exists(fileName));
+    }
 };
 
 QTEST_GUILESS_MAIN(IniFileTest)
@@ -0,0 +1,124 @@
+#include <QStandardItemModel>
+#include <QTest>
+
+#include <ui/instanceview/InstanceView.h>
+
+// a flat model like the instance list, with the instances spread over a few groups
+static void fillModel(QStandardItemModel& model, int count, int groups)
+{
+    model.clear();
+    for (int i = 0; i < count; i++) {
+        auto item = new QStandardItem(QString("Instance %1").arg(i));
+        item->setData(QString("Group %1").arg(i % groups), InstanceViewRoles::GroupRole);
+        model.appendRow(item);
+    }
+    // the instance list keeps each group together
+    model.setSortRole(InstanceViewRoles::GroupRole);
+    model.sort(0);
+}
+
+class InstanceViewTest : public QObject {
+    Q_OBJECT
+
+    void showView(InstanceView& view, QStandardItemModel& model)
+    {
+        view.setModel(&model);
+        view.resize(800, 600);
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        view.doItemsLayout();
+    }
+
+   private slots:
+    void test_indexAt()
+    {
+        QStandardItemModel model;
+        fillModel(model, 500, 7);
+        InstanceView view;
+        showView(view, model);
+
+        for (int i = 0; i < model.rowCount(); i++) {
+            auto index = model.index(i, 0);
+            auto rect = view.visualRect(index);
+            QVERIFY(rect.isValid());
+            QCOMPARE(view.indexAt(rect.center()), index);
+        }
+        QVERIFY(!view.indexAt(QPoint(1, 1)).isValid());
+    }
+
+    void test_groupChange()
+    {
+        QStandardItemModel model;
+        fillModel(model, 100, 4);
+        InstanceView view;
+        showView(view, model);
+
+        auto index = model.index(0, 0);
+        auto before = view.visualRect(index);
+        model.setData(index, QString("A New Group"), InstanceViewRoles::GroupRole);
+        auto after = view.visualRect(index);
+        QVERIFY(before != after);
+        QCOMPARE(view.indexAt(after.center()), index);
+    }
+
+    void benchmark_layout_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::newRow("1k instances") << 1000;
+        QTest::newRow("10k instances") << 10000;
+    }
+    void benchmark_layout()
+    {
+        QFETCH(int, count);
+        QStandardItemModel model;
+        fillModel(model, count, 20);
+        InstanceView view;
+        showView(view, model);
+
+        QBENCHMARK
+        {
+            view.doItemsLayout();
+        }
+    }
+
+    void benchmark_dataChanged_data() { benchmark_layout_data(); }
+    void benchmark_dataChanged()
+    {
+        QFETCH(int, count);
+        QStandardItemModel model;
+        fillModel(model, count, 20);
+        InstanceView view;
+        showView(view, model);
+
+        auto index = model.index(count / 2, 0);
+        int i = 0;
+        QBENCHMARK
+        {
+            model.setData(index, QString("Renamed %1").arg(i++));
+            // forces the pending layout
+            view.visualRect(index);
+        }
+    }
+
+    void benchmark_indexAt_data() { benchmark_layout_data(); }
+    void benchmark_indexAt()
+    {
+        QFETCH(int, count);
+        QStandardItemModel model;
+        fillModel(model, count, 20);
+        InstanceView view;
+        showView(view, model);
+
+        auto last = view.visualRect(model.index(count - 1, 0));
+        QBENCHMARK
+        {
+            for (int y = 0; y < last.bottom(); y += last.bottom() / 1000 + 1) {
+                view.indexAt(QPoint(last.center().x(), y));
+            }
+        }
+    }
+};
+
+QTEST_MAIN(InstanceViewTest)
+
+#include "InstanceView_test.moc"
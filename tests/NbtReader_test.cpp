@@ -0,0 +1,179 @@
+#include <QBuffer>
+#include <QTest>
+
+#include <GZip.h>
+#include <minecraft/NbtReader.h>
+
+#include <io/stream_reader.h>
+#include <io/stream_writer.h>
+#include <tag_array.h>
+#include <tag_compound.h>
+#include <tag_list.h>
+#include <tag_primitive.h>
+#include <tag_string.h>
+#include <sstream>
+
+static QByteArray writeNbt(const nbt::tag_compound& root)
+{
+    std::ostringstream s;
+    nbt::io::write_tag("", root, s);
+    return QByteArray(s.str().data(), static_cast<int>(s.str().size()));
+}
+
+// a level.dat as written by a big modpack, where mod data dwarfs the few fields the launcher reads
+static QByteArray makeLevelDat(int modCount)
+{
+    nbt::tag_compound data;
+    data.insert("LevelName", std::string("Modded World"));
+    data.insert("LastPlayed", nbt::tag_long(1700000000000));
+    data.insert("GameType", nbt::tag_int(1));
+    nbt::tag_compound worldGen;
+    worldGen.insert("seed", nbt::tag_long(-4172144997902289642));
+    data.insert("WorldGenSettings", nbt::value(std::move(worldGen)));
+
+    nbt::tag_list registries;
+    for (int i = 0; i < modCount; i++) {
+        nbt::tag_compound mod;
+        mod.insert("ModId", std::string("mod_") + std::to_string(i));
+        mod.insert("ModVersion", std::string("1.0.") + std::to_string(i));
+        std::vector<int32_t> ids(256);
+        for (int j = 0; j < 256; j++)
+            ids[j] = i * 256 + j;
+        mod.insert("Ids", nbt::tag_int_array(std::move(ids)));
+        registries.push_back(std::move(mod));
+    }
+    nbt::tag_compound forge;
+    forge.insert("Registries", nbt::value(std::move(registries)));
+    data.insert("fml", nbt::value(std::move(forge)));
+
+    nbt::tag_compound root;
+    root.insert("Data", nbt::value(std::move(data)));
+
+    QByteArray compressed;
+    GZip::zip(writeNbt(root), compressed);
+    return compressed;
+}
+
+static const QStringList levelDatPaths = { "Data.LevelName", "Data.LastPlayed", "Data.GameType", "Data.WorldGenSettings.seed",
+                                           "Data.RandomSeed" };
+
+class NbtReaderTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_levelDat()
+    {
+        auto levelDat = makeLevelDat(10);
+        QBuffer buffer(&levelDat);
+        buffer.open(QIODevice::ReadOnly);
+
+        NbtReader reader(levelDatPaths);
+        QVERIFY2(reader.readCompressed(&buffer), qPrintable(reader.errorString()));
+        QCOMPARE(reader.rootName(), QString());
+        QVERIFY(reader.isCompound("Data"));
+        QVERIFY(reader.isCompound("Data.WorldGenSettings"));
+        QVERIFY(!reader.isCompound("Data.fml"));
+
+        QCOMPARE(reader.value("Data.LevelName").toString(), QString("Modded World"));
+        QCOMPARE(reader.value("Data.LastPlayed").userType(), qMetaTypeId<qlonglong>());
+        QCOMPARE(reader.value("Data.LastPlayed").toLongLong(), qlonglong(1700000000000));
+        QCOMPARE(reader.value("Data.GameType").userType(), qMetaTypeId<int>());
+        QCOMPARE(reader.value("Data.GameType").toInt(), 1);
+        QCOMPARE(reader.value("Data.WorldGenSettings.seed").toLongLong(), qlonglong(-4172144997902289642));
+        QVERIFY(!reader.contains("Data.RandomSeed"));
+    }
+
+    void test_serversDat()
+    {
+        nbt::tag_list servers;
+        for (int i = 0; i < 3; i++) {
+            nbt::tag_compound server;
+            server.insert("name", std::string("Server ") + std::to_string(i));
+            server.insert("ip", std::string("127.0.0.") + std::to_string(i));
+            if (i == 1)
+                server.insert("acceptTextures", nbt::tag_byte(1));
+            servers.push_back(std::move(server));
+        }
+        nbt::tag_compound root;
+        root.insert("servers", nbt::value(std::move(servers)));
+        auto serversDat = writeNbt(root);
+        QBuffer buffer(&serversDat);
+        buffer.open(QIODevice::ReadOnly);
+
+        NbtReader reader({ "servers" });
+        QVERIFY2(reader.read(&buffer), qPrintable(reader.errorString()));
+        auto list = reader.value("servers").toList();
+        QCOMPARE(list.size(), 3);
+        QCOMPARE(list[2].toMap().value("ip").toString(), QString("127.0.0.2"));
+        auto acceptTextures = list[1].toMap().value("acceptTextures");
+        QCOMPARE(acceptTextures.userType(), qMetaTypeId<qint8>());
+        QCOMPARE(acceptTextures.value<qint8>(), qint8(1));
+        QVERIFY(!list[0].toMap().contains("acceptTextures"));
+    }
+
+    void test_truncated()
+    {
+        auto levelDat = makeLevelDat(10);
+        QByteArray uncompressed;
+        QVERIFY(GZip::unzip(levelDat, uncompressed));
+        uncompressed.chop(100);
+        QBuffer buffer(&uncompressed);
+        buffer.open(QIODevice::ReadOnly);
+
+        NbtReader reader(levelDatPaths);
+        QVERIFY(!reader.read(&buffer));
+        QVERIFY(!reader.errorString().isEmpty());
+    }
+
+    void test_hugeLength()
+    {
+        // a byte array claiming to be 2 GiB long, with nothing after it
+        QByteArray data;
+        data.append(char(10)).append(2, '\0');
+        data.append(char(7)).append('\0').append(char(7)).append("servers");
+        data.append(char(0x7f)).append(3, char(0xff));
+
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        NbtReader reader({ "servers" });
+        QVERIFY(!reader.read(&buffer));
+        QVERIFY(!reader.errorString().isEmpty());
+
+        // compressed, the size of the data isn't known up front
+        QByteArray compressed;
+        QVERIFY(GZip::zip(data, compressed));
+        QBuffer compressedBuffer(&compressed);
+        compressedBuffer.open(QIODevice::ReadOnly);
+        QVERIFY(!reader.readCompressed(&compressedBuffer));
+        QVERIFY(!reader.errorString().isEmpty());
+    }
+
+    void benchmark_selective()
+    {
+        auto levelDat = makeLevelDat(5000);
+        QBENCHMARK
+        {
+            QBuffer buffer(&levelDat);
+            buffer.open(QIODevice::ReadOnly);
+            NbtReader reader(levelDatPaths);
+            QVERIFY(reader.readCompressed(&buffer));
+        }
+    }
+
+    void benchmark_fullTree()
+    {
+        auto levelDat = makeLevelDat(5000);
+        QBENCHMARK
+        {
+            QByteArray uncompressed;
+            QVERIFY(GZip::unzip(levelDat, uncompressed));
+            std::istringstream s(std::string(uncompressed.constData(), uncompressed.size()));
+            auto pair = nbt::io::read_compound(s);
+            QVERIFY(pair.second != nullptr);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(NbtReaderTest)
+
+#include "NbtReader_test.moc"
@@ -0,0 +1,85 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <modplatform/helpers/OverrideUtils.h>
+
+static void writeFile(const QString& path, const QByteArray& contents)
+{
+    FS::ensureFilePathExists(path);
+    FS::write(path, contents);
+}
+
+class OverrideUtilsTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_diffAndDrop()
+    {
+        QTemporaryDir staging;
+        QTemporaryDir installed;
+        QVERIFY(staging.isValid() && installed.isValid());
+
+        writeFile(FS::PathCombine(staging.path(), "config/same.cfg"), "unchanged");
+        writeFile(FS::PathCombine(installed.path(), "config/same.cfg"), "unchanged");
+        writeFile(FS::PathCombine(staging.path(), "config/other.cfg"), "new contents");
+        writeFile(FS::PathCombine(installed.path(), "config/other.cfg"), "old contents");
+        // used to be a downloaded file of the pack, and is now shipped as an identical override
+        writeFile(FS::PathCombine(staging.path(), "mods/moved.jar"), "jar");
+        writeFile(FS::PathCombine(installed.path(), "mods/moved.jar"), "jar");
+        writeFile(FS::PathCombine(installed.path(), "mods/gone.jar"), "gone");
+
+        auto delta = Override::diffOverrides({ "config/same.cfg", "config/old.cfg" }, staging.path(), installed.path());
+        delta.unchanged.sort();
+        QCOMPARE(delta.unchanged, QStringList({ "config/same.cfg", "mods/moved.jar" }));
+        QCOMPARE(delta.changed, QStringList({ "config/other.cfg" }));
+        QCOMPARE(delta.removed, QStringList({ "config/old.cfg" }));
+        QCOMPARE(delta.bytesToWrite, qint64(12));
+
+        QDir installed_dir(installed.path());
+        QStringList files_to_remove = { installed_dir.absoluteFilePath("mods/moved.jar"), installed_dir.absoluteFilePath("mods/gone.jar") };
+        Override::dropUnchanged(delta, staging.path(), files_to_remove);
+
+        QVERIFY(!QFileInfo::exists(FS::PathCombine(staging.path(), "config/same.cfg")));
+        QVERIFY(!QFileInfo::exists(FS::PathCombine(staging.path(), "mods/moved.jar")));
+        QVERIFY(QFileInfo::exists(FS::PathCombine(staging.path(), "config/other.cfg")));
+        // the kept file must not be deleted as a leftover of the old version
+        QCOMPARE(files_to_remove, QStringList({ installed_dir.absoluteFilePath("mods/gone.jar") }));
+    }
+
+    void test_layeredOverrides()
+    {
+        QTemporaryDir staging;
+        QTemporaryDir installed;
+        QVERIFY(staging.isValid() && installed.isValid());
+        auto overrides = FS::PathCombine(staging.path(), "overrides");
+        auto client_overrides = FS::PathCombine(staging.path(), "client-overrides");
+
+        // the client override is what's installed, the regular one must not be written over it
+        writeFile(FS::PathCombine(overrides, "options.txt"), "server");
+        writeFile(FS::PathCombine(client_overrides, "options.txt"), "client");
+        writeFile(FS::PathCombine(installed.path(), "options.txt"), "client");
+        // moved from one layer to the other, so it's still part of the pack
+        writeFile(FS::PathCombine(overrides, "config/moved.cfg"), "moved");
+        writeFile(FS::PathCombine(installed.path(), "config/moved.cfg"), "moved");
+
+        auto deltas = Override::diffOverrides(
+            { { { "options.txt" }, overrides }, { { "options.txt", "config/moved.cfg" }, client_overrides } }, installed.path());
+        QCOMPARE(deltas.size(), 2);
+        QCOMPARE(deltas[0].shadowed, QStringList({ "options.txt" }));
+        QCOMPARE(deltas[0].unchanged, QStringList({ "config/moved.cfg" }));
+        QVERIFY(deltas[0].changed.isEmpty());
+        QCOMPARE(deltas[1].unchanged, QStringList({ "options.txt" }));
+        QVERIFY(deltas[1].removed.isEmpty());
+
+        QStringList files_to_remove;
+        Override::dropUnchanged(deltas[0], overrides, files_to_remove);
+        Override::dropUnchanged(deltas[1], client_overrides, files_to_remove);
+        QVERIFY(!QFileInfo::exists(FS::PathCombine(overrides, "options.txt")));
+        QVERIFY(!QFileInfo::exists(FS::PathCombine(client_overrides, "options.txt")));
+    }
+};
+
+QTEST_GUILESS_MAIN(OverrideUtilsTest)
+
+#include "OverrideUtils_test.moc"
@@ -0,0 +1,143 @@
+#include <QTest>
+
+#include <pathmatcher/CompiledMatcher.h>
+#include <pathmatcher/MultiMatcher.h>
+#include <pathmatcher/RegexpMatcher.h>
+#include <pathmatcher/SimplePrefixMatcher.h>
+
+static const QStringList logPatterns = { ".*\\.log(\\.[0-9]*)?(\\.gz)?$", "crash-.*\\.txt", "IDMap dump.*\\.txt$",
+                                         "ModLoader\\.txt(\\..*)?$" };
+static const QString copyFilter = "[.]?minecraft/saves|[.]?minecraft/options.txt|[.]?minecraft/mods|[.]?minecraft/config|instance.cfg";
+static const QStringList prefixes = { "prismlauncher.cfg", "logs/", "accounts.json", "assets/", "icons/", "instances/", "mods/" };
+
+// roughly what the files of a big modded instance look like
+static QStringList makePaths(int count)
+{
+    static const QStringList dirs = { ".minecraft/mods", ".minecraft/config/some_mod", ".minecraft/saves/World/region",
+                                      ".minecraft/resourcepacks", ".minecraft/logs", ".minecraft/crash-reports", "instances/a/.minecraft",
+                                      "assets/objects/ab", "libraries/net/minecraft" };
+    static const QStringList names = { "r.0.%1.mca", "mod-%1.jar", "config-%1.toml", "latest.log", "debug-%1.log.gz", "crash-%1.txt",
+                                       "IDMap dump %1.txt", "ModLoader.txt.%1", "options.txt", "servers.dat" };
+    QStringList paths;
+    for (int i = 0; i < count; i++) {
+        paths.append(dirs[i % dirs.size()] + '/' + names[(i / dirs.size()) % names.size()].arg(i));
+    }
+    paths << "instance.cfg"
+          << "prismlauncher.cfg"
+          << "logs"
+          << "mods/"
+          << "MINECRAFT/MODS/a.jar"
+          << "a.LOG";
+    return paths;
+}
+
+class PathMatcherTest : public QObject {
+    Q_OBJECT
+
+    IPathMatcher::Ptr multiMatcher()
+    {
+        auto matcher = std::make_shared<MultiMatcher>();
+        for (auto& pattern : logPatterns)
+            matcher->add(std::make_shared<RegexpMatcher>(pattern));
+        matcher->add(std::make_shared<RegexpMatcher>(copyFilter));
+        for (auto& prefix : prefixes)
+            matcher->add(std::make_shared<SimplePrefixMatcher>(prefix));
+        return matcher;
+    }
+
+    IPathMatcher::Ptr compiledMatcher()
+    {
+        auto matcher = std::make_shared<CompiledMatcher>();
+        for (auto& pattern : logPatterns)
+            matcher->addRegexp(pattern);
+        matcher->addRegexp(copyFilter);
+        for (auto& prefix : prefixes)
+            matcher->addPrefix(prefix);
+        return matcher;
+    }
+
+   private slots:
+    void test_requiredLiterals_data()
+    {
+        QTest::addColumn<QString>("regexp");
+        QTest::addColumn<QStringList>("literals");
+        QTest::newRow("log") << logPatterns[0] << QStringList{ ".log" };
+        QTest::newRow("crash") << logPatterns[1] << QStringList{ "crash-" };
+        QTest::newRow("alternatives") << copyFilter
+                                      << QStringList{ "minecraft/saves", "minecraft/options", "minecraft/mods", "minecraft/config",
+                                                      "instance" };
+        QTest::newRow("optional") << "abc?d" << QStringList{ "ab" };
+        QTest::newRow("repeated") << "ab+cde" << QStringList{ "cde" };
+        QTest::newRow("counted") << "xa{2,3}bcd" << QStringList{ "bcd" };
+        QTest::newRow("classes") << "\\d+\\.\\w+" << QStringList{ "." };
+        QTest::newRow("no literal") << "foo|.*" << QStringList{};
+        QTest::newRow("extended") << "(?x) a b c" << QStringList{};
+        QTest::newRow("hex") << "a\\x41bc" << QStringList{ "bc" };
+        QTest::newRow("braced hex") << "\\x{41}xyz" << QStringList{ "xyz" };
+        QTest::newRow("octal") << "\\012ab" << QStringList{ "ab" };
+        QTest::newRow("control") << "\\cAbc" << QStringList{ "bc" };
+        QTest::newRow("quoted") << "x\\Q.*\\Eyz" << QStringList{ "yz" };
+    }
+    void test_requiredLiterals()
+    {
+        QFETCH(QString, regexp);
+        QFETCH(QStringList, literals);
+        QCOMPARE(CompiledMatcher::requiredLiterals(regexp), literals);
+    }
+
+    void test_escapedCharacters()
+    {
+        CompiledMatcher matcher;
+        matcher.addRegexp("a\\x41b\\.txt");
+        QVERIFY(matcher.matches("dir/aAb.txt"));
+        QVERIFY(!matcher.matches("dir/a41b.txt"));
+    }
+
+    void test_sameAsMultiMatcher()
+    {
+        auto multi = multiMatcher();
+        auto compiled = compiledMatcher();
+        for (auto& path : makePaths(2000)) {
+            QVERIFY2(multi->matches(path) == compiled->matches(path), qPrintable(path));
+        }
+    }
+
+    void test_caseSensitivity()
+    {
+        CompiledMatcher sensitive;
+        sensitive.addRegexp("minecraft/mods");
+        QVERIFY(!sensitive.matches("MINECRAFT/MODS/a.jar"));
+        CompiledMatcher insensitive;
+        insensitive.addRegexp("minecraft/mods", Qt::CaseInsensitive);
+        QVERIFY(insensitive.matches("MINECRAFT/MODS/a.jar"));
+        insensitive.addRegexp("(a)\\1.txt");
+        QVERIFY(insensitive.matches("dir/aa.txt"));
+        QVERIFY(!insensitive.matches("dir/ab.txt"));
+    }
+
+    void benchmark_multiMatcher()
+    {
+        auto matcher = multiMatcher();
+        auto paths = makePaths(100000);
+        QBENCHMARK
+        {
+            for (auto& path : paths)
+                matcher->matches(path);
+        }
+    }
+
+    void benchmark_compiledMatcher()
+    {
+        auto matcher = compiledMatcher();
+        auto paths = makePaths(100000);
+        QBENCHMARK
+        {
+            for (auto& path : paths)
+                matcher->matches(path);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(PathMatcherTest)
+
+#include "PathMatcher_test.moc"
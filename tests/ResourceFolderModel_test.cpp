@@ -33,6 +33,8 @@
  *      limitations under the License.
  */
 
+#include <QDateTime>
+#include <QFile>
 #include <QTemporaryDir>
 #include <QTest>
 #include <QTimer>
@@ -61,6 +63,41 @@
                                                                                         \
     disconnect(&model, nullptr, &loop, nullptr);
 
+/* Counts the work done by the model instead of parsing anything. */
+class CountingFolderModel : public ResourceFolderModel {
+   public:
+    using ResourceFolderModel::ResourceFolderModel;
+
+    int update_tasks = 0;
+    int parse_tasks = 0;
+
+   protected:
+    Task* createUpdateTask() override
+    {
+        update_tasks++;
+        return ResourceFolderModel::createUpdateTask();
+    }
+    Task* createParseTask(Resource&) override
+    {
+        parse_tasks++;
+        return nullptr;
+    }
+};
+
+static void writeFile(const QString& path, const QByteArray& data)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(data);
+}
+
+static void touchFile(const QString& path)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+}
+
 class ResourceFolderModelTest : public QObject {
     Q_OBJECT
 
@@ -243,6 +280,51 @@ class ResourceFolderModelTest : public QObject {
         QVERIFY(res_2.enabled() == initial_enabled_res_2);
         QVERIFY(res_2.internal_id() == id_2);
     }
+
+    void test_watcherDeltas()
+    {
+        QTemporaryDir tmp;
+        for (int i = 0; i < 200; i++)
+            writeFile(FS::PathCombine(tmp.path(), QString("mod_%1.jar").arg(i)), "mod");
+
+        CountingFolderModel model(QDir(tmp.path()), nullptr);
+        { EXEC_UPDATE_TASK(model.startWatching(), ) }
+        QCOMPARE(model.size(), 200);
+        QCOMPARE(model.update_tasks, 1);
+        QCOMPARE(model.parse_tasks, 200);
+        model.parse_tasks = 0;
+
+        // a new file only gets that file parsed
+        auto added = FS::PathCombine(tmp.path(), "added.jar");
+        { EXEC_UPDATE_TASK(writeFile(added, "new mod"), ) }
+        QCOMPARE(model.size(), 201);
+        QCOMPARE(model.parse_tasks, 1);
+
+        // so does a modified one
+        { EXEC_UPDATE_TASK(touchFile(added), ) }
+        QCOMPARE(model.size(), 201);
+        QCOMPARE(model.parse_tasks, 2);
+
+        // a rename keeps the parsed resource
+        auto renamed = FS::PathCombine(tmp.path(), "renamed.jar");
+        { EXEC_UPDATE_TASK(QFile::rename(added, renamed), QVERIFY) }
+        QCOMPARE(model.size(), 201);
+        QCOMPARE(model.parse_tasks, 2);
+        QCOMPARE(model.at(200).fileinfo().fileName(), QString("renamed.jar"));
+
+        // and a removal just drops the row
+        { EXEC_UPDATE_TASK(QFile::remove(FS::PathCombine(tmp.path(), "mod_0.jar")), QVERIFY) }
+        QCOMPARE(model.size(), 200);
+        QCOMPARE(model.parse_tasks, 2);
+
+        // hidden files aren't listed by the update task, so they aren't added here either
+        { EXEC_UPDATE_TASK(writeFile(FS::PathCombine(tmp.path(), ".hidden.jar"), "mod"), ) }
+        QCOMPARE(model.size(), 200);
+        QCOMPARE(model.parse_tasks, 2);
+
+        QCOMPARE(model.update_tasks, 1);
+        model.stopWatching();
+    }
 };
 
 QTEST_GUILESS_MAIN(ResourceFolderModelTest)
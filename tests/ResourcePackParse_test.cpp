@@ -16,11 +16,14 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <QBuffer>
+#include <QImage>
 #include <QTest>
 #include <QTimer>
 
 #include <FileSystem.h>
 
+#include <minecraft/mod/PackThumbnail.h>
 #include <minecraft/mod/ResourcePack.h>
 #include <minecraft/mod/tasks/LocalResourcePackParseTask.h>
 
@@ -71,6 +74,28 @@ class ResourcePackParseTest : public QObject {
         QVERIFY(pack.description() == "o quartel pegou fogo, policia deu sinal, acode acode acode a bandeira nacional");
         QVERIFY(valid == false);  // no assets dir
     }
+
+    void test_packThumbnail()
+    {
+        QImage source(1024, 512, QImage::Format_ARGB32);
+        source.fill(Qt::red);
+        QByteArray png;
+        QBuffer buffer(&png);
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(source.save(&buffer, "PNG"));
+
+        auto thumbnail = PackThumbnail::decode(png);
+        QCOMPARE(thumbnail.size(), QSize(128, 64));
+        QCOMPARE(thumbnail.pixelColor(64, 32), QColor(Qt::red));
+
+        QByteArray small_png;
+        QBuffer small_buffer(&small_png);
+        small_buffer.open(QIODevice::WriteOnly);
+        QVERIFY(source.copy(0, 0, 16, 16).save(&small_buffer, "PNG"));
+        QCOMPARE(PackThumbnail::decode(small_png).size(), QSize(16, 16));  // small images are never scaled up
+
+        QVERIFY(PackThumbnail::decode(png.left(64)).isNull());
+    }
 };
 
 QTEST_GUILESS_MAIN(ResourcePackParseTest)
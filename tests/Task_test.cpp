@@ -1,3 +1,4 @@
+#include <QSignalSpy>
 #include <QTest>
 #include <QThread>
 #include <QTimer>
@@ -6,6 +7,7 @@
 #include <tasks/MultipleOptionsTask.h>
 #include <tasks/SequentialTask.h>
 #include <tasks/Task.h>
+#include <tasks/TaskGraph.h>
 
 #include <array>
 
@@ -22,6 +24,14 @@ class BasicTask : public Task {
     void executeTask() override { emitSucceeded(); }
 };
 
+/* Always fails. Only used for testing. */
+class FailingTask : public Task {
+    Q_OBJECT
+
+   private:
+    void executeTask() override { emitFailed("failing on purpose"); }
+};
+
 /* Does nothing. Only used for testing. */
 class BasicTask_MultiStep : public Task {
     Q_OBJECT
@@ -124,6 +134,45 @@ class TaskTest : public QObject {
         QCOMPARE(t.getTotalProgress(), total);
     }
 
+    void test_progressIsThrottled()
+    {
+        BasicTask t;
+        QSignalSpy spy(&t, &Task::progress);
+
+        for (int i = 1; i <= 10000; i++)
+            t.setProgress(i, 10000);
+
+        // the first update goes out right away, the rest is folded into the next frame
+        QCOMPARE(spy.count(), 1);
+        QTRY_COMPARE(spy.count(), 2);
+        QCOMPARE(spy.last().at(0).toLongLong(), 10000);
+        QCOMPARE(spy.last().at(1).toLongLong(), 10000);
+    }
+
+    void test_progressFromWorkers()
+    {
+        BasicTask t;
+        QSignalSpy spy(&t, &Task::progress);
+        t.setProgress(0, 40000);
+
+        QList<QThread*> workers;
+        for (int i = 0; i < 4; i++) {
+            workers.append(QThread::create([&t] {
+                for (int j = 0; j < 10000; j++)
+                    t.advanceProgress();
+            }));
+            workers.last()->start();
+        }
+        for (auto worker : workers) {
+            worker->wait();
+            delete worker;
+        }
+
+        QCOMPARE(t.getProgress(), qint64(40000));
+        QTRY_COMPARE(spy.last().at(0).toLongLong(), 40000);
+        QVERIFY(spy.count() < 100);
+    }
+
     void test_basicRun()
     {
         BasicTask t;
@@ -245,6 +294,29 @@ class TaskTest : public QObject {
         QVERIFY2(QTest::qWaitFor([&]() { return t.isFinished(); }, 1000), "Task didn't finish as it should.");
     }
 
+    void test_taskGraphOptionalFailure()
+    {
+        auto optional = makeShared<FailingTask>();
+        auto dependent = makeShared<BasicTask>();
+        auto required = makeShared<FailingTask>();
+
+        TaskGraph graph;
+        graph.addOptionalTask(optional);
+        graph.addTask(dependent, { optional });
+
+        graph.start();
+        QVERIFY2(QTest::qWaitFor([&]() { return graph.isFinished(); }, 1000), "Task didn't finish as it should.");
+        QVERIFY(graph.wasSuccessful());
+        QVERIFY(!optional->wasSuccessful());
+        QVERIFY(dependent->wasSuccessful());
+
+        TaskGraph failing;
+        failing.addTask(required);
+        failing.start();
+        QVERIFY2(QTest::qWaitFor([&]() { return failing.isFinished(); }, 1000), "Task didn't finish as it should.");
+        QVERIFY(!failing.wasSuccessful());
+    }
+
     void test_stackOverflowInConcurrentTask()
     {
         QEventLoop loop;
@@ -15,8 +15,26 @@
 
 #include <QTest>
 
+#include <algorithm>
+
 #include <Version.h>
 
+// roughly the shape of the Forge and NeoForge version lists from the meta server
+static QStringList loaderVersions()
+{
+    QStringList versions;
+    for (int major = 10; major <= 50; major++) {
+        for (int minor = 0; minor < 6; minor++) {
+            for (int build = 0; build < 40; build++) {
+                versions.append(QString("%1.%2.%3.%4").arg(major).arg(minor).arg(build).arg(1000 + major * 40 + build));
+                versions.append(QString("%1.%2.%3-beta").arg(major).arg(minor).arg(build));
+            }
+        }
+    }
+    std::reverse(versions.begin(), versions.end());
+    return versions;
+}
+
 class VersionTest : public QObject {
     Q_OBJECT
 
@@ -178,6 +196,39 @@ class VersionTest : public QObject {
         QCOMPARE(v1 > v2, !lessThan && !equal);
         QCOMPARE(v1 == v2, equal);
     }
+
+    void test_sortLoaderVersions()
+    {
+        QList<Version> versions;
+        for (auto& version : loaderVersions())
+            versions.append(Version(version));
+        std::sort(versions.begin(), versions.end());
+        QCOMPARE(versions.first().toString(), QString("10.0.0-beta"));
+        QCOMPARE(versions.last().toString(), QString("50.5.39.3039"));
+        QVERIFY(std::is_sorted(versions.begin(), versions.end()));
+    }
+
+    void benchmark_sortParsedOnce()
+    {
+        auto strings = loaderVersions();
+        QBENCHMARK
+        {
+            QList<Version> versions;
+            for (auto& version : strings)
+                versions.append(Version(version));
+            std::sort(versions.begin(), versions.end());
+        }
+    }
+
+    void benchmark_sortParsedPerComparison()
+    {
+        auto strings = loaderVersions();
+        QBENCHMARK
+        {
+            auto versions = strings;
+            std::sort(versions.begin(), versions.end(), [](const QString& a, const QString& b) { return Version(a) < Version(b); });
+        }
+    }
 };
 
 QTEST_GUILESS_MAIN(VersionTest)